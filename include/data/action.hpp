@@ -112,6 +112,45 @@ struct ActionBase {
     } override_;
 };
 
+// A list of actions, as read from plugin data, along with a compact form of it for execution.
+//
+// Before applying each action, execute_actions() resolves its overrides and checks its owner,
+// attribute, and tag filters. Each Op holds the result of unpacking those optional fields,
+// computed once when the list is read, in a small record beside its neighbors, so that running
+// a list only reads the (much larger) Action itself for the parts that apply.
+class ActionList {
+  public:
+    struct Op {
+        enum Flags : uint8_t {
+            OVERRIDE_SUBJECT = 0x01,
+            OVERRIDE_DIRECT  = 0x02,
+            FILTER           = 0x04,  // Has attribute or tag filters.
+            REFLEXIVE        = 0x08,
+        };
+
+        const Action* action;
+        Owner         owner;
+        uint8_t       flags;
+    };
+
+    ActionList();
+    explicit ActionList(std::vector<Action> actions);
+    ActionList(ActionList&&);
+    ActionList& operator=(ActionList&&);
+    ~ActionList();
+
+    const Action* begin() const;
+    const Action* end() const;
+    size_t        size() const { return _ops.size(); }
+
+    const Op* ops_begin() const { return _ops.data(); }
+    const Op* ops_end() const { return _ops.data() + _ops.size(); }
+
+  private:
+    std::vector<Action> _actions;
+    std::vector<Op>     _ops;  // Points into _actions, which moves along with it.
+};
+
 struct AgeAction : public ActionBase {
     sfz::optional<bool> relative;  // if true, add value to age; if false, set age to value
     Range<ticks>        value;     // age range
@@ -184,7 +223,7 @@ struct FlashAction : public ActionBase {
 };
 
 struct GroupAction : public ActionBase {
-    std::vector<Action> of;
+    ActionList of;
 };
 
 struct HealAction : public ActionBase {
@@ -439,6 +478,10 @@ template <>
 struct field_reader<Action> {
     static Action read(path_value x);
 };
+template <>
+struct field_reader<ActionList> {
+    static ActionList read(path_value x);
+};
 
 }  // namespace antares
 
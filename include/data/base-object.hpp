@@ -168,10 +168,10 @@ class BaseObject {
     } weapons;
 
     struct Destroy {
-        bool                die;
-        bool                neutralize;
-        bool                release_energy;
-        std::vector<Action> action;
+        bool       die;
+        bool       neutralize;
+        bool       release_energy;
+        ActionList action;
     } destroy;
 
     struct Expire {
@@ -179,12 +179,12 @@ class BaseObject {
             sfz::optional<Range<ticks>> age;  // starting random age
             bool                        animation = false;
         } after;
-        bool                die;
-        std::vector<Action> action;
+        bool       die;
+        ActionList action;
     } expire;
 
     struct Create {
-        std::vector<Action> action;
+        ActionList action;
     } create;
 
     struct Collide {
@@ -192,20 +192,20 @@ class BaseObject {
             bool subject = false;
             bool direct  = false;
         } as;
-        bool                solid  = false;
-        bool                edge   = false;
-        int32_t             damage = 0;
-        std::vector<Action> action;
+        bool       solid  = false;
+        bool       edge   = false;
+        int32_t    damage = 0;
+        ActionList action;
     } collide;
 
     struct Activate {
         sfz::optional<Range<ticks>> period;
-        std::vector<Action>         action;
+        ActionList                  action;
     } activate;
 
     struct Arrive {
-        Distance            distance;
-        std::vector<Action> action;
+        Distance   distance;
+        ActionList action;
     } arrive;
 
     enum class Layer { NONE = 0, BASES = 1, SHIPS = 2, SHOTS = 3 };
@@ -23,6 +23,7 @@
 #include <sfz/sfz.hpp>
 #include <vector>
 
+#include "data/action.hpp"
 #include "data/cash.hpp"
 #include "data/counter.hpp"
 #include "data/distance.hpp"
@@ -34,7 +35,6 @@
 
 namespace antares {
 
-union Action;
 union ConditionWhen;
 struct Initial;
 class path_value;
@@ -265,7 +265,7 @@ struct Condition {
 
     sfz::optional<ObjectRef> subject;
     sfz::optional<ObjectRef> direct;
-    std::vector<Action>      action;
+    ActionList               action;
 
     static const Condition*            get(int n);
     static HandleList<const Condition> all();
@@ -44,6 +44,8 @@ struct Info {
     sfz::optional<pn::string> about;
 
     pn::string version;
+
+    sfz::optional<int64_t> object_capacity;
 };
 
 Info info(path_value x);
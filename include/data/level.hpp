@@ -43,6 +43,7 @@ struct Race;
 struct LevelBase {
     enum class Type { NONE, SOLO, NET, DEMO };
     enum class PlayerType { HUMAN, CPU };
+    enum class AIMode { LEGACY, PLANNER };
 
     Type type = Type::DEMO;
 
@@ -73,6 +74,7 @@ struct LevelBase {
     sfz::optional<Rect>       starmap;
     sfz::optional<secs>       start_time;
     sfz::optional<int64_t>    angle;
+    sfz::optional<int64_t>    object_capacity;
 
     std::vector<Initial>   initials;
     std::vector<Condition> conditions;
@@ -85,6 +87,7 @@ struct DemoLevel : LevelBase {
         NamedHandle<const Race> race;
         sfz::optional<Hue>      hue;
         sfz::optional<Fixed>    earning_power;
+        AIMode                  ai = AIMode::LEGACY;
     };
 
     std::vector<Player> players;
@@ -97,6 +100,7 @@ struct SoloLevel : LevelBase {
         NamedHandle<const Race> race;
         sfz::optional<Hue>      hue;
         sfz::optional<Fixed>    earning_power;
+        AIMode                  ai = AIMode::LEGACY;
     };
     std::vector<Player> players;
 
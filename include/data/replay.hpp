@@ -43,16 +43,25 @@ struct ReplayData {
         void                 write_to(pn::output_view out) const;
     };
 
-    Scenario            scenario;
-    int32_t             chapter_id;
-    int32_t             global_seed;
-    uint64_t            duration;
-    std::vector<Action> actions;
+    Scenario              scenario;
+    int32_t               chapter_id;
+    int32_t               global_seed;
+    uint64_t              duration;
+    std::vector<Action>   actions;
+    uint64_t              sync_interval = 0;  // If nonzero, `syncs` has g.sync every this often.
+    std::vector<uint32_t> syncs;
 
     ReplayData();
-    ReplayData(pn::data_view in);
 
+    // Reads a replay in either format. Actions before tick `from` are skipped; in the columnar
+    // format, blocks before it aren't decoded at all.
+    ReplayData(pn::data_view in, uint64_t from = 0);
+
+    // Writes the replay as NLRP, the format ReplayBuilder records in.
     void write_to(pn::output_view out) const;
+    // Writes the replay in the columnar format, which is smaller and faster to read, and can
+    // embed syncs. See replay.cpp for the layout.
+    void write_columnar_to(pn::output_view out) const;
     void key_down(uint64_t at, uint32_t key);
     void key_up(uint64_t at, uint32_t key);
 };
@@ -123,6 +123,16 @@ class PixMap {
     // @throws std::runtime_error if `this->size()` and `pix.size()` are not equal.
     virtual void composite(const PixMap& pix);
 
+    // Blends a sprite overlay into this PixMap, tinted with `hue`.
+    //
+    // The red channel of each overlay pixel selects a shade of `hue`, and its alpha channel says
+    // how much of that shade to blend in.  The alpha channel of this PixMap is unchanged.
+    //
+    // @param [in] overlay        the overlay to blend in.
+    // @param [in] hue            the hue to tint the overlay with.
+    // @throws std::runtime_error if `this->size()` and `overlay.size()` are not equal.
+    void tint_overlay(const PixMap& overlay, Hue hue);
+
     // See class documentation below.
     class View;
 
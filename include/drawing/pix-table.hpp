@@ -19,6 +19,7 @@
 #ifndef ANTARES_DRAWING_PIX_TABLE_HPP_
 #define ANTARES_DRAWING_PIX_TABLE_HPP_
 
+#include <memory>
 #include <vector>
 
 #include "drawing/pix-map.hpp"
@@ -26,11 +27,65 @@
 
 namespace antares {
 
+const int32_t kAtlasPageSize = 1024;
+
+// Packs sprite frames into shared pages, so that many sprites can be drawn from one texture.
+// Each page keeps the frames' overlays in a second layer, so that they can be drawn in any hue.
+class SpriteAtlas {
+  public:
+    class Page;
+
+    SpriteAtlas();
+    SpriteAtlas(const SpriteAtlas&) = delete;
+    SpriteAtlas& operator=(const SpriteAtlas&) = delete;
+    ~SpriteAtlas();
+
+    // Copies `image` and `overlay` into a page with room for them, and sets `rect` to where they
+    // went.
+    const Page* add(const PixMap& image, const PixMap& overlay, Rect* rect);
+    void        clear();
+
+    size_t page_count() const { return _pages.size(); }
+
+  private:
+    std::vector<std::unique_ptr<Page>> _pages;
+};
+
+class SpriteAtlas::Page {
+  public:
+    Page(Size size, int index);
+    Page(const Page&) = delete;
+    Page& operator=(const Page&) = delete;
+    ~Page();
+
+    // Finds room for a frame of the given size, left to right along shelves that run top to
+    // bottom. Returns false if the page is full.
+    bool place(Size size, Rect* rect);
+    void copy(const Rect& rect, const PixMap& image, const PixMap& overlay);
+
+    // Uploads the page the first time it's drawn, and again if frames were added since.
+    const Texture& texture() const;
+
+  private:
+    const int       _index;
+    ArrayPixMap     _pix_map;
+    ArrayPixMap     _overlay;
+    int32_t         _shelf_top    = 0;
+    int32_t         _shelf_height = 0;
+    int32_t         _shelf_right  = 0;
+    mutable Texture _texture;
+    mutable bool    _dirty = true;
+};
+
 class NatePixTable {
   public:
     class Frame;
 
-    NatePixTable(pn::string_view name, Hue hue);
+    // If `atlas` is given, frames are packed into it, and only get textures of their own when
+    // they're drawn alone, with Frame::texture().
+    NatePixTable(pn::string_view name, Hue hue, SpriteAtlas* atlas = nullptr);
+    // Shares the frames of `base`, which must outlive this table, but in `hue`.
+    NatePixTable(const NatePixTable& base, Hue hue);
     NatePixTable(const NatePixTable&) = delete;
     NatePixTable(NatePixTable&&)      = default;
     NatePixTable& operator=(const NatePixTable&) = delete;
@@ -47,27 +102,39 @@ class NatePixTable {
 
 class NatePixTable::Frame {
   public:
-    Frame(Rect bounds, const PixMap& image, pn::string_view name, int frame);
-    Frame(Rect bounds, const PixMap& image, pn::string_view name, int frame, const PixMap& overlay,
-          Hue hue);
+    Frame(Rect bounds, const PixMap& image, const PixMap& overlay, Hue hue, pn::string_view name,
+          int frame, SpriteAtlas* atlas);
+    Frame(const Frame& base, Hue hue);
     Frame(Frame&&) = default;
     ~Frame();
 
-    uint16_t       width() const;
-    uint16_t       height() const;
-    Size           size() const { return Size{width(), height()}; };
-    Point          center() const;
-    const PixMap&  pix_map() const;
-    const Texture& texture() const;
+    uint16_t        width() const;
+    uint16_t        height() const;
+    Size            size() const { return Size{width(), height()}; };
+    Point           center() const;
+    Hue             hue() const { return _hue; }
+    pn::string_view name() const { return _name; }
+    const PixMap&   pix_map() const;
+    const Texture&  texture() const;
+
+    // The atlas page holding this frame, and where, or nullptr if it wasn't packed. The page has
+    // the frame's image and overlay, but the overlay isn't tinted until the frame is drawn.
+    const SpriteAtlas::Page* page() const { return _page; }
+    const Rect&              page_rect() const { return _page_rect; }
 
   private:
-    void load_image(const PixMap& pix);
-    void load_overlay(const PixMap& pix, Hue hue);
-    void build(pn::string_view name, int frame);
+    const Frame& base() const { return _base ? *_base : *this; }
 
-    Rect        _bounds;
-    ArrayPixMap _pix_map;
-    Texture     _texture;
+    Rect                                 _bounds;
+    Hue                                  _hue;
+    pn::string                           _name;
+    const Frame*                         _base = nullptr;  // set if pixels are shared
+    ArrayPixMap                          _image;
+    ArrayPixMap                          _overlay;
+    mutable std::unique_ptr<ArrayPixMap> _tinted;  // _image, with _overlay in _hue
+    mutable Texture                      _texture;
+    const SpriteAtlas::Page*             _page = nullptr;
+    Rect                                 _page_rect;
 };
 
 }  // namespace antares
@@ -25,6 +25,7 @@
 #include "data/handle.hpp"
 #include "drawing/color.hpp"
 #include "drawing/pix-table.hpp"
+#include "game/slot-allocator.hpp"
 #include "math/fixed.hpp"
 #include "math/scale.hpp"
 
@@ -50,9 +51,10 @@ typedef void (*draw_tiny_t)(const Rect& rect, const RgbColor& color);
 
 class Sprite {
   public:
-    static Sprite*            get(int number);
-    static Handle<Sprite>     none() { return Handle<Sprite>(-1); }
-    static HandleList<Sprite> all() { return HandleList<Sprite>(0, size); }
+    static Sprite*                get(int number);
+    static Handle<Sprite>         none() { return Handle<Sprite>(-1); }
+    static HandleList<Sprite>     all() { return HandleList<Sprite>(0, size); }
+    static UsedHandleList<Sprite> live();  // Only the sprites in use.
 
     Sprite();
 
@@ -70,12 +72,13 @@ class Sprite {
     } tinyColor;
     bool        killMe;
     draw_tiny_t draw_tiny;
+    int32_t     drawIndex;  // Position in its layer's draw list, or -1 if in none.
 
     BaseObject::Icon icon;
 
   private:
-    friend void         SpriteHandlingInit();
-    static const size_t size = 500;
+    friend void   ResetAllSprites(int32_t object_capacity);
+    static size_t size;
 };
 
 extern Scale gAbsoluteScale;
@@ -88,18 +91,21 @@ class Pix {
     const NatePixTable* cursor();
 
   private:
+    SpriteAtlas                                        _atlas;
     std::map<std::pair<pn::string, Hue>, NatePixTable> _pix;
     std::unique_ptr<NatePixTable>                      _cursor;
 };
 
 void           SpriteHandlingInit();
-void           ResetAllSprites();
+void           ResetAllSprites(int32_t object_capacity);
 Rect           scale_sprite_rect(const NatePixTable::Frame& frame, Point where, Scale scale);
 Handle<Sprite> AddSprite(
         Point where, NatePixTable* table, pn::string_view name, Hue hue, int16_t whichShape,
         Scale scale, sfz::optional<BaseObject::Icon> icon, BaseObject::Layer layer, Hue tiny_hue,
         uint8_t tiny_shade);
 void RemoveSprite(Handle<Sprite> sprite);
+void SetSpriteLayer(Handle<Sprite> sprite, BaseObject::Layer layer);
+void RebuildSpriteLayers();  // After sprites are restored wholesale, as from a snapshot.
 void draw_sprites();
 void CullSprites();
 
@@ -78,6 +78,19 @@ class StyledText {
             pn::string_view text, WrapMetrics metrics, RgbColor fore_color = RgbColor::white(),
             RgbColor back_color = RgbColor::black());
 
+    // Like interface(), but reuses the layout from a recent call with the same text, metrics,
+    // and colors, instead of laying the text out (and loading its pictures) again. Interface
+    // text is redrawn every frame, so the same few strings come up over and over. The result is
+    // valid until the next call.
+    static const StyledText& cached_interface(
+            pn::string_view text, WrapMetrics metrics, RgbColor fore_color = RgbColor::white(),
+            RgbColor back_color = RgbColor::black());
+
+    // Drops every layout kept by cached_interface(). They hold textures for inline pictures and
+    // refer to fonts by address, so this is called when the video driver's main loop ends, and
+    // before the fonts or the plugin are loaded again.
+    static void clear_cached_interfaces();
+
     bool                               empty() const;
     int                                height() const;
     int                                auto_width() const;
@@ -20,6 +20,8 @@
 #define ANTARES_DRAWING_TEXT_HPP_
 
 #include <pn/string>
+#include <unordered_map>
+#include <vector>
 
 #include "drawing/sprite-handling.hpp"
 #include "lang/casts.hpp"
@@ -54,7 +56,12 @@ class Font {
   private:
     Rect glyph_rect(pn::rune rune) const;
 
-    std::map<pn::rune, Rect> _glyphs;
+    // Glyphs are looked up for every character drawn or measured, so those for the first 256
+    // code points (ASCII and Latin-1) are kept in a table indexed by rune. The rest, like the
+    // punctuation and symbols of Mac Roman, are hashed. Runes without a glyph get '?'.
+    std::vector<Rect>                  _dense_glyphs;
+    std::unordered_map<uint32_t, Rect> _sparse_glyphs;
+    Rect                               _missing_glyph;
 };
 
 Font font(pn::string_view name);
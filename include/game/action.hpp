@@ -20,6 +20,7 @@
 #define ANTARES_GAME_ACTION_HPP_
 
 #include <memory>
+#include <vector>
 
 #include "data/base-object.hpp"
 
@@ -32,13 +33,21 @@ namespace antares {
 bool action_filter_applies_to(const Action& action, Handle<SpaceObject> target);
 
 void exec(
-        const std::vector<Action>& actions, Handle<SpaceObject> sObject,
-        Handle<SpaceObject> dObject, Point offset);
+        const ActionList& actions, Handle<SpaceObject> sObject, Handle<SpaceObject> dObject,
+        Point offset);
 
+class StateArchive;
+
+// Delayed actions, in a binary min-heap ordered by when they're due.
+//
+// Each action is keyed by the value of `now` at which it's due, and `now` advances by one major
+// tick each time the queue runs, so advancing doesn't need to touch every queued action. The
+// heap grows as needed, so queuing an action never fails.
 struct actionQueueType;
 struct ActionQueue {
-    actionQueueType*                   first;
-    std::unique_ptr<actionQueueType[]> data;
+    ticks                        now;
+    int64_t                      next_seq;
+    std::vector<actionQueueType> heap;
 
     ActionQueue();
     ~ActionQueue();
@@ -46,6 +55,19 @@ struct ActionQueue {
 
 void reset_action_queue();
 void execute_action_queue();
+void archive_action_queue(StateArchive& a);  // For Snapshot.
+
+int32_t action_queue_used();  // Number of delayed actions currently queued.
+
+// A delayed action waiting in g.action_queue, as seen by state hashing.
+struct QueuedAction {
+    ticks   scheduled_time;  // Time remaining until the action runs.
+    int32_t subject_id;
+    int32_t direct_id;
+    Point   offset;
+    int32_t count;  // Number of actions remaining in the list.
+};
+std::vector<QueuedAction> queued_actions();  // In execution order.
 
 }  // namespace antares
 
@@ -33,7 +33,7 @@ enum {
     kAIsHuman    = 1 << 0,
     kAIsRemote   = 1 << 1,
     kAIsComputer = 1 << 2,
-    kABit4       = 1 << 3,
+    kAIsPlanner  = 1 << 3,  // computer player using the strategic planner
     kABit5       = 1 << 4,
     kABit6       = 1 << 5,
     kABit7       = 1 << 6,
@@ -64,6 +64,8 @@ enum {
     kABit32      = 1 << 31,
 };
 
+class StateArchive;
+
 const size_t  kMaxPlayerNum    = 4;
 const int32_t kMaxDestObject   = 10;  // we keep special track of dest objects for AI
 const int32_t kAdmiralScoreNum = 3;
@@ -163,6 +165,7 @@ class Admiral {
     Handle<SpaceObject>            _considerShip;
     int32_t                        _considerShipID      = -1;
     int32_t                        _considerDestination = kNoShip;
+    int32_t                        _planDelay           = 0;
     Handle<Destination>            _buildAtObject;  // # of destination object to build at
     NamedHandle<const Race>        _race;
     Cash                           _cash                    = Cash{Fixed::zero()};
@@ -184,12 +187,17 @@ class Admiral {
     pn::string                     _name;
 
   private:
+    friend void archive_admirals(StateArchive& a);
+
     Admiral() = default;
 
+    void decide(Handle<SpaceObject> anObject);
+    void plan();
     void think_build();
 };
 
 void ResetAllDestObjectData();
+void archive_admirals(StateArchive& a);  // Admirals and destinations, for Snapshot.
 
 Handle<Destination> MakeNewDestination(
         Handle<SpaceObject> object, const std::vector<BuildableObject>& canBuildType, Fixed earn,
@@ -215,6 +223,17 @@ void RemoveObjectFromDestination(Handle<SpaceObject> o);
 void AdmiralThink();
 void StopBuilding(Handle<Destination> whichDestObject);
 
+// Friendly and hostile strength near `destObject`, from the point of view of `owner`.
+void local_strength(
+        Handle<SpaceObject> destObject, const Admiral* owner, Fixed* friendValue,
+        Fixed* foeValue);
+
+// The value to `anObject` of heading for `destObject`, before any random perturbation, given
+// the strengths near `destObject` from local_strength(). Used by both AI modes.
+Fixed target_value(
+        Handle<SpaceObject> anObject, Handle<SpaceObject> destObject, Fixed friendValue,
+        Fixed foeValue, int32_t blitzkrieg);
+
 void    AlterAdmiralScore(Counter counter, int32_t amount);
 int32_t GetAdmiralScore(Counter counter);
 int32_t GetAdmiralShipsLeft(Handle<Admiral> whichAdmiral);
@@ -27,6 +27,7 @@
 #include "data/level.hpp"
 #include "drawing/color.hpp"
 #include "game/action.hpp"
+#include "game/slot-allocator.hpp"
 #include "game/starfield.hpp"
 #include "math/random.hpp"
 #include "math/units.hpp"
@@ -81,10 +82,15 @@ struct GlobalState {
     Handle<SpaceObject>            ship;     // Local player's flagship.
     Handle<SpaceObject>            root;     // Head of LL of active objs, in creation time order.
 
+    SlotAllocator object_slots;  // Which objects are in use; its capacity is the size of objects.
+
     std::unique_ptr<Vector[]>      vectors;       // Auxiliary info for kIsVector objects.
     std::unique_ptr<Destination[]> destinations;  // Auxiliary info for kIsDestination objects.
     std::unique_ptr<Sprite[]>      sprites;       // Auxiliary info for objects with sprites.
 
+    SlotAllocator vector_slots;  // Which vectors are in use (active).
+    SlotAllocator sprite_slots;  // Which sprites are in use (have a table).
+
     std::vector<Handle<SpaceObject>> initials;     // May change due to assume initial.
     std::vector<int32_t>             initial_ids;  // Ditto.
 
@@ -103,6 +109,7 @@ struct GlobalState {
     bool                     radar_on;     // Maybe false if player ship is offline.
 
     std::unique_ptr<Label[]> labels;
+    SlotAllocator            label_slots;    // Which labels are in use (active).
     Handle<Label>            control_label;  // Local player's current control object.
     Handle<Label>            target_label;   // Local player's current target object.
     Handle<Label>            message_label;  // Destroyed, captured, lost messages.
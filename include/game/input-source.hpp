@@ -66,6 +66,11 @@ class ReplayInputSource : public InputSource {
   public:
     explicit ReplayInputSource(ReplayData* data);
 
+    // Records g.sync into the replay every `interval` ticks, replacing any syncs it had.
+    void record_syncs(uint64_t interval);
+    // Throws if g.sync ever differs from a sync recorded in the replay.
+    void verify_syncs();
+
     virtual void start();
     virtual bool get(Handle<Admiral> admiral, game_ticks at, EventReceiver& key_map);
 
@@ -74,8 +79,17 @@ class ReplayInputSource : public InputSource {
     virtual void mouse_down(const MouseDownEvent& event);
 
   private:
+    enum SyncMode {
+        IGNORE_SYNCS,
+        RECORD_SYNCS,
+        VERIFY_SYNCS,
+    };
+
     bool advance(EventReceiver& receiver);
+    void check_sync(game_ticks at);
 
+    ReplayData*                                                       _data;
+    SyncMode                                                          _sync_mode;
     game_ticks                                                        _duration;
     std::multimap<std::pair<int, game_ticks>, std::unique_ptr<Event>> _events;
     bool                                                              _exit;
@@ -23,6 +23,7 @@
 
 #include "data/base-object.hpp"
 #include "drawing/styled-text.hpp"
+#include "game/slot-allocator.hpp"
 
 namespace antares {
 
@@ -32,19 +33,21 @@ class Label {
     static const int32_t kMaxLabelNum = 16;
     static const ticks   kVisibleTime;
 
-    static Label*            get(int number);
-    static Handle<Label>     none() { return Handle<Label>(-1); }
-    static HandleList<Label> all() { return {0, kMaxLabelNum}; }
+    static Label*                get(int number);
+    static Handle<Label>         none() { return Handle<Label>(-1); }
+    static HandleList<Label>     all() { return {0, kMaxLabelNum}; }
+    static UsedHandleList<Label> live();  // Only the labels in use.
 
     static void          init();
     static void          reset();
     static Handle<Label> add(
             int16_t h, int16_t v, int16_t hoff, int16_t voff, Handle<SpaceObject> object,
             bool objectLink, Hue hue);
-    static void draw();
-    static void update_contents(ticks units_done);
-    static void update_positions(ticks units_done);
-    static void show_all();
+    static void    draw();
+    static void    update_contents(ticks units_done);
+    static void    update_positions(ticks units_done);
+    static void    show_all();
+    static int32_t used();  // Number of labels currently in use.
 
     void remove();
 
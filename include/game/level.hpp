@@ -38,7 +38,8 @@ struct LoadState {
     int32_t max  = 1;  // So that (step / max) is 0 before construct_level() starts.
 };
 
-LoadState start_construct_level(const Level& level);
+LoadState start_construct_level(
+        const Level& level, sfz::optional<int32_t> object_capacity = sfz::nullopt);
 void      construct_level(LoadState* state);
 void      DeclareWinner(Handle<Admiral> whichPlayer, const Level* nextLevel, pn::string_view text);
 void      GetLevelFullScaleAndCorner(int32_t rotation, Point* corner, Scale* scale, Rect* bounds);
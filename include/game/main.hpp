@@ -19,13 +19,19 @@
 #ifndef ANTARES_GAME_MAIN_HPP_
 #define ANTARES_GAME_MAIN_HPP_
 
+#include <map>
+#include <memory>
+
+#include "data/level.hpp"
 #include "data/replay.hpp"
+#include "game/snapshot.hpp"
 #include "ui/card.hpp"
 #include "ui/interface-handling.hpp"
 
 namespace antares {
 
 class InputSource;
+class PlayerShip;
 union Level;
 
 enum GameResult {
@@ -61,6 +67,46 @@ class MainPlay : public Card {
     InputSource*      _input_source;
 };
 
+// Plays `level` to completion with input from `input`, running only the simulation. Nothing
+// is drawn, and the starfield, labels, radar, and other display state are not updated, so this
+// is much faster than playing through MainPlay, but produces the same result. sys.video must
+// still be able to create textures, because sprite tables are loaded along with the level.
+//
+// If `ai` is given, every computer admiral uses it, whatever the level asks for.
+GameResult play_sim_only(
+        const Level& level, InputSource* input,
+        sfz::optional<LevelBase::AIMode> ai = sfz::nullopt);
+
+// Plays `level` without drawing, like play_sim_only(), but can move to any tick, forwards or
+// backwards. While simulating, it keeps a Snapshot every `keyframe_interval`, so that a seek
+// only has to re-simulate from the nearest keyframe at or before its target. If
+// `keyframe_interval` is zero, it keeps only the Snapshot of the start of the level.
+//
+// If `object_capacity` is given, it is used in place of the level's or plugin's object capacity.
+class SimSeeker {
+  public:
+    SimSeeker(
+            const Level& level, InputSource* input, ticks keyframe_interval,
+            sfz::optional<int32_t> object_capacity = sfz::nullopt);
+    SimSeeker(const SimSeeker&) = delete;
+    SimSeeker& operator=(const SimSeeker&) = delete;
+    ~SimSeeker();
+
+    // Moves the simulation to `t`, or to the end of the game if it ends before `t`.
+    void seek(game_ticks t);
+
+    bool       finished() const;
+    GameResult result() const;
+
+  private:
+    void step();
+
+    InputSource* const             _input;
+    const ticks                    _keyframe_interval;
+    std::unique_ptr<PlayerShip>    _player_ship;
+    std::map<game_ticks, Snapshot> _keyframes;
+};
+
 }  // namespace antares
 
 #endif  // ANTARES_GAME_MAIN_HPP_
@@ -23,20 +23,16 @@
 
 #include "data/base-object.hpp"
 #include "game/space-object.hpp"
+#include "game/target-index.hpp"
 
 namespace antares {
 
-enum Allegiance {
-    FRIENDLY_OR_HOSTILE = 0,
-    FRIENDLY,
-    HOSTILE,
-};
-
 void fire_weapon(
         Handle<SpaceObject> subject, Handle<SpaceObject> target, SpaceObject::Weapon& weapon,
         const std::vector<fixedPointType>& positions);
 void                NonplayerShipThink();
 void                HitObject(Handle<SpaceObject> anObject, Handle<SpaceObject> sObject);
+void                InvalidateManualSelectIndex();  // When objects move or are added.
 Handle<SpaceObject> GetManualSelectObject(
         Handle<SpaceObject> sourceObject, int32_t direction, uint32_t inclusiveAttributes,
         uint32_t exclusiveAttributes, const uint64_t* fartherThan, Handle<SpaceObject> currentShip,
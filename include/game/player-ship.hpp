@@ -99,6 +99,7 @@ struct PlayerEvent {
 
 class GameCursor;
 class InputSource;
+class StateArchive;
 
 class PlayerShip : public EventReceiver {
   public:
@@ -127,6 +128,8 @@ class PlayerShip : public EventReceiver {
     bool entering_message() const { return _message.editing(); }
 
   private:
+    friend void archive(StateArchive& a, PlayerShip& ship);
+
     bool active() const;
 
     uint32_t                 gTheseKeys;
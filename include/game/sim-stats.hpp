@@ -0,0 +1,56 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_GAME_SIM_STATS_HPP_
+#define ANTARES_GAME_SIM_STATS_HPP_
+
+#include <stdint.h>
+#include <sfz/sfz.hpp>
+
+namespace antares {
+
+// Measures how close the simulation comes to its fixed limits.
+//
+// While one is installed as sys.sim_stats, the simulation samples how many space objects,
+// sprites, labels, vectors, and delayed actions are in use at the end of every major tick, and
+// counts each time one was needed but none was free. None of these stop the game when they run
+// out; the new object, sprite, label, or vector is silently dropped instead. The delayed-action
+// queue grows as needed, so it has no capacity and never drops anything.
+struct SimStats {
+    struct Pool {
+        // Capacity is none if the pool is unbounded. Dropped counts the times an allocation
+        // failed because the pool was full.
+        sfz::optional<int32_t> capacity;
+        int32_t                peak    = 0;
+        int64_t                dropped = 0;
+
+        void sample(int32_t used, sfz::optional<int32_t> capacity);
+    };
+
+    int64_t major_ticks = 0;
+    Pool    objects;
+    Pool    sprites;
+    Pool    labels;
+    Pool    vectors;
+    Pool    actions;
+
+    void sample();
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_SIM_STATS_HPP_
@@ -0,0 +1,92 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_GAME_SLOT_ALLOCATOR_HPP_
+#define ANTARES_GAME_SLOT_ALLOCATOR_HPP_
+
+#include <stdint.h>
+#include <vector>
+
+#include "data/handle.hpp"
+
+namespace antares {
+
+// Tracks which slots of a fixed-size pool are in use.
+//
+// allocate() always returns the lowest-numbered free slot, as a linear scan for the first free
+// slot would. Slot numbers decide the order that objects are visited in, so this is part of the
+// simulation, and replays depend on it. Free slots are kept in a two-level bitmap: one bit per
+// slot, and one summary bit per 64 slots, so finding the lowest free slot only has to look at
+// one summary word per 4096 slots.
+class SlotAllocator {
+  public:
+    // Resizes the pool to `capacity` slots, all free.
+    void reset(int32_t capacity);
+
+    // Returns the lowest-numbered free slot and marks it used, or -1 if all slots are used.
+    int32_t allocate();
+
+    // Marks `slot` as free or used.
+    void release(int32_t slot);
+    void set_used(int32_t slot, bool used);
+
+    bool    is_used(int32_t slot) const;
+    int32_t next_used(int32_t slot) const;  // Lowest used slot >= `slot`, or capacity() if none.
+    int32_t capacity() const { return _capacity; }
+    int32_t used() const { return _used; }
+
+  private:
+    int32_t               _capacity = 0;
+    int32_t               _used     = 0;
+    std::vector<uint64_t> _free;     // bit set for each free slot
+    std::vector<uint64_t> _summary;  // bit set for each nonzero word of _free
+};
+
+// Handles to the used slots of a pool, in increasing order, so that passes over the pool visit
+// only its live entries. Iterating sees slots allocated and released along the way exactly as a
+// scan over every slot, checking each as it goes, would.
+template <typename T>
+class UsedHandleList {
+  public:
+    explicit UsedHandleList(const SlotAllocator& slots) : _slots(&slots) {}
+    class iterator {
+        friend class UsedHandleList;
+
+      public:
+        Handle<T> operator*() const { return Handle<T>(_number); }
+        iterator& operator++() {
+            _number = _slots->next_used(_number + 1);
+            return *this;
+        }
+        bool operator==(iterator other) const { return _number == other._number; }
+        bool operator!=(iterator other) const { return _number != other._number; }
+
+      private:
+        iterator(const SlotAllocator* slots, int32_t number) : _slots(slots), _number(number) {}
+        const SlotAllocator* _slots;
+        int32_t              _number;
+    };
+    iterator begin() const { return iterator(_slots, _slots->next_used(0)); }
+    iterator end() const { return iterator(_slots, _slots->capacity()); }
+
+  private:
+    const SlotAllocator* _slots;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_SLOT_ALLOCATOR_HPP_
@@ -0,0 +1,140 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_GAME_SNAPSHOT_HPP_
+#define ANTARES_GAME_SNAPSHOT_HPP_
+
+#include <pn/string>
+#include <sfz/sfz.hpp>
+#include <type_traits>
+#include <vector>
+
+#include "math/units.hpp"
+
+namespace antares {
+
+class PlayerShip;
+
+// Copies simulation state into or out of a Snapshot's buffer.
+//
+// Each piece of state is described once, as a sequence of calls to operator(), and the same
+// description serves for saving and loading, so the two can't drift apart. Trivially copyable
+// values are copied bytewise; other types need an overload of `archive(StateArchive&, T&)`.
+// Pointers (e.g. to BaseObjects) are stored as-is, so a buffer is only meaningful to the
+// process that wrote it, and only until the level is unloaded.
+class StateArchive {
+  public:
+    static StateArchive saving(std::vector<uint8_t>* out) { return StateArchive(out, nullptr); }
+    static StateArchive loading(const std::vector<uint8_t>& in) {
+        return StateArchive(nullptr, &in);
+    }
+
+    bool is_loading() const { return _in != nullptr; }
+
+    template <typename T>
+    StateArchive& operator()(T& x) {
+        io(x, std::integral_constant<bool, std::is_trivially_copyable<T>::value>{});
+        return *this;
+    }
+
+    StateArchive& operator()(pn::string& s);
+    StateArchive& operator()(std::vector<bool>& v);
+
+    template <typename T>
+    StateArchive& operator()(std::vector<T>& v) {
+        size_t size = v.size();
+        (*this)(size);
+        if (is_loading()) {
+            v.clear();
+            v.resize(size);
+        }
+        for (T& x : v) {
+            (*this)(x);
+        }
+        return *this;
+    }
+
+    template <typename T>
+    StateArchive& operator()(sfz::optional<T>& x) {
+        bool has_value = x.has_value();
+        (*this)(has_value);
+        if (!is_loading()) {
+            if (has_value) {
+                (*this)(*x);
+            }
+        } else if (has_value) {
+            T value;
+            (*this)(value);
+            x.emplace(std::move(value));
+        } else {
+            x.reset();
+        }
+        return *this;
+    }
+
+    template <typename T, size_t N>
+    StateArchive& operator()(T (&array)[N]) {
+        for (T& x : array) {
+            (*this)(x);
+        }
+        return *this;
+    }
+
+  private:
+    StateArchive(std::vector<uint8_t>* out, const std::vector<uint8_t>* in)
+            : _out{out}, _in{in} {}
+
+    template <typename T>
+    void io(T& x, std::true_type) {
+        bytes(&x, sizeof(x));
+    }
+
+    template <typename T>
+    void io(T& x, std::false_type) {
+        archive(*this, x);
+    }
+
+    void bytes(void* data, size_t size);
+
+    std::vector<uint8_t>*       _out;
+    const std::vector<uint8_t>* _in;
+    size_t                      _pos = 0;
+};
+
+// All simulation state at one point in time, packed into one contiguous buffer.
+//
+// Restoring a snapshot puts the simulation back exactly as it was when the snapshot was taken,
+// so that continuing from there gives the same results as if it had never been interrupted.
+// Snapshots should be taken between major ticks. Purely cosmetic state (labels, messages, the
+// starfield, and instrument display) isn't captured.
+class Snapshot {
+  public:
+    explicit Snapshot(PlayerShip& player_ship);
+
+    void restore(PlayerShip& player_ship) const;
+
+    game_ticks time() const { return _time; }
+    size_t     size() const { return _data.size(); }
+
+  private:
+    game_ticks           _time;
+    std::vector<uint8_t> _data;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_SNAPSHOT_HPP_
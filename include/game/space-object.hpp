@@ -28,7 +28,9 @@ namespace antares {
 
 struct BuildableObject;
 
-const int32_t kMaxSpaceObject = 250;
+// Object capacity, unless the level or plugin sets `object_capacity`.
+const int32_t kMaxSpaceObject      = 250;
+const int32_t kObjectCapacityLimit = 16384;
 
 const ticks kTimeToCheckHome = secs(15);
 
@@ -85,14 +87,16 @@ enum kPresenceStateType {
 class SpaceObject {
   public:
     static SpaceObject* get(int number) {
-        if ((0 <= number) && (number < kMaxSpaceObject)) {
+        if ((0 <= number) && (number < g.object_slots.capacity())) {
             return &g.objects[number];
         }
         return nullptr;
     }
 
     static Handle<SpaceObject>     none() { return Handle<SpaceObject>(-1); }
-    static HandleList<SpaceObject> all() { return HandleList<SpaceObject>(0, kMaxSpaceObject); }
+    static HandleList<SpaceObject> all() {
+        return HandleList<SpaceObject>(0, g.object_slots.capacity());
+    }
 
     SpaceObject() = default;
     SpaceObject(
@@ -134,7 +138,6 @@ class SpaceObject {
     Point collisionGrid;      // [524224..524352), or [0x7ffc0..0x80040)
     Point distanceGrid;       // [32764..32772), or [0x7ffc..0x8004)
 
-    Handle<SpaceObject> nextNearObject;
     Handle<SpaceObject> nextFarObject;
     Handle<SpaceObject> previousObject;
     Handle<SpaceObject> nextObject;
@@ -269,9 +272,12 @@ class SpaceObject {
     uint8_t                 originalColor = 0;
 };
 
-void SpaceObjectHandlingInit(void);
-void ResetAllSpaceObjects(void);
-void RemoveAllSpaceObjects(void);
+void    SpaceObjectHandlingInit(void);
+int32_t object_capacity(const Level& level, sfz::optional<int32_t> override = sfz::nullopt);
+void    ResetAllSpaceObjects(int32_t capacity);
+void    RemoveAllSpaceObjects(void);
+void    RecountSpaceObjects();  // After objects are changed wholesale, as by Snapshot.
+void    CheckObjectCounts();    // Throws if incremental counts disagree with a full scan.
 
 Handle<SpaceObject> CreateAnySpaceObject(
         const BaseObject& whichBase, fixedPointType* velocity, Point* location, int32_t direction,
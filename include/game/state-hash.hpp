@@ -0,0 +1,116 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_GAME_STATE_HASH_HPP_
+#define ANTARES_GAME_STATE_HASH_HPP_
+
+#include <stdint.h>
+#include <pn/input>
+#include <pn/output>
+#include <vector>
+
+namespace antares {
+
+// The simulation state at the end of one major tick.
+//
+// Unlike g.sync, which only sums object locations, a StateRecord covers every field that feeds
+// back into the simulation: g.random and other game-wide state, each active admiral, each
+// queued action, and each active space object. Each is flattened into 32-bit words, and hashed.
+// Usually only the hashes are kept: one for the whole state, and one for each kind of entry, so
+// that a divergence can be narrowed down to a subsystem. The words themselves (a dump) are kept
+// only when asked for, so that two runs can be compared field-by-field at the ticks of interest.
+struct StateRecord {
+    enum Kind : uint8_t {
+        GLOBAL  = 0,
+        ADMIRAL = 1,
+        ACTION  = 2,
+        OBJECT  = 3,
+    };
+    static const int kKindCount = 4;
+
+    struct Entry {
+        Kind                 kind;
+        int32_t              index;  // Admiral or object number, or position in action queue.
+        std::vector<int32_t> fields;
+    };
+
+    int64_t            tick;
+    uint64_t           digest;                    // FNV-1a over `tick` and `kind_digests`.
+    uint64_t           kind_digests[kKindCount];  // FNV-1a over the entries of each kind.
+    std::vector<Entry> entries;                   // Empty unless this tick was dumped.
+
+    // Sets `digest` and `kind_digests` from `tick` and `entries`.
+    void seal();
+
+    // Sets `digest` from `tick` and `kind_digests`.
+    void seal_digest();
+
+    void write_to(pn::output_view out) const;
+};
+bool read_from(pn::input_view in, StateRecord* record);
+
+// The state at the current tick. Its entries are only filled in if `dump` is set; otherwise
+// only the digests are, and no per-entry vectors are built.
+StateRecord     capture_state(bool dump);
+pn::string_view state_kind_name(StateRecord::Kind kind);
+pn::string_view state_field_name(StateRecord::Kind kind, int field);
+
+// Where two logs written by StateHashLog first differ.
+struct StateDivergence {
+    enum Result {
+        NONE,    // The logs match.
+        LENGTH,  // One log ends before the other.
+        TICK,    // The logs record different ticks.
+        STATE,   // The state differs at `tick`.
+    };
+
+    Result  result = NONE;
+    int64_t ticks  = 0;  // Number of records that matched.
+    int64_t tick   = 0;  // First tick that differs, if any.
+
+    // With STATE, the kinds of entry whose digests differ, and if both logs have a dump of
+    // `tick`, the first entry or field that differs. With LENGTH or TICK, a description.
+    std::vector<StateRecord::Kind> kinds;
+    bool                           dumped = false;
+    pn::string                     detail;
+};
+StateDivergence diff_state_logs(pn::input_view a, pn::input_view b);
+
+// While one exists, appends a StateRecord to a sidecar file at the end of every major tick.
+//
+// Each record holds only hashes, unless it's a dump. Dumps are written every `dump_interval`
+// ticks (none if 0), and on every tick from `dump_from` on (none if negative). To find what
+// diverged, compare hash-only logs first, then write dumps from the tick where they diverge.
+class StateHashLog {
+  public:
+    StateHashLog(pn::string_view path, int64_t dump_interval = 0, int64_t dump_from = -1);
+    StateHashLog(const StateHashLog&) = delete;
+    StateHashLog& operator=(const StateHashLog&) = delete;
+    ~StateHashLog();
+
+    void record();
+
+  private:
+    pn::output _out;
+    int64_t    _dump_interval;
+    int64_t    _dump_from;
+    int64_t    _next_dump = 0;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_STATE_HASH_HPP_
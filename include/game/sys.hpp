@@ -33,6 +33,8 @@ class SoundDriver;
 class PrefsDriver;
 class VideoDriver;
 class Ledger;
+class StateHashLog;
+struct SimStats;
 
 struct SystemGlobals {
     struct {
@@ -55,7 +57,9 @@ struct SystemGlobals {
     VideoDriver* video = nullptr;
     PrefsDriver* prefs = nullptr;
 
-    Ledger* ledger = nullptr;
+    Ledger*       ledger     = nullptr;
+    StateHashLog* state_hash = nullptr;
+    SimStats*     sim_stats  = nullptr;
 
     std::vector<pn::string> messages;
 
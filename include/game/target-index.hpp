@@ -0,0 +1,88 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_GAME_TARGET_INDEX_HPP_
+#define ANTARES_GAME_TARGET_INDEX_HPP_
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+
+#include "math/geometry.hpp"
+
+namespace antares {
+
+enum Allegiance {
+    FRIENDLY_OR_HOSTILE = 0,
+    FRIENDLY,
+    HOSTILE,
+};
+
+// A uniform grid over the objects that manual selection can pick from, for
+// GetManualSelectObject().
+//
+// The grid holds only where each object is, and its place in g.root order, which is the order
+// that selection cycles through them; it is built once per major tick, and reused by every
+// selection until the next. Whether an object can be picked is asked of `eligible` during the
+// query, so that changes to attributes or owners made in between are seen.
+//
+// select() makes exactly the choice that walking g.root and testing every object would: the
+// nearest object in the cone, or the nearest beyond the current selection, with ties going to
+// the object reached first when cycling from `start`. It just visits the grid cells nearest the
+// origin first, and stops once no remaining cell can hold anything nearer.
+class TargetIndex {
+  public:
+    struct Entry {
+        int32_t number;    // handle number of the object
+        Point   location;  // its location
+    };
+
+    struct Query {
+        Point    origin;        // location of the selecting object
+        int32_t  direction;     // center of the selection cone
+        uint64_t farther_than;  // prefer objects beyond this squared distance
+        int32_t  start;         // number of the object where cycling starts, or -1 for the first
+        int32_t  current;       // number of the current selection, or -1
+    };
+
+    // Replaces the contents of the index with `entries`, in g.root order.
+    void build(const std::vector<Entry>& entries);
+
+    // Returns the number of the object to select, or -1 if none qualifies. Only objects for
+    // which `eligible(number)` is true are considered.
+    int32_t select(const Query& q, const std::function<bool(int32_t number)>& eligible) const;
+
+    // Squared distance between `a` and `b`, as manual selection measures it.
+    static uint64_t distance(Point a, Point b);
+
+    // True if `to` lies within the selection cone centered on `direction` as seen from `from`.
+    static bool in_cone(Point from, Point to, int32_t direction);
+
+  private:
+    Point                _min;        // location of cell (0, 0)
+    int32_t              _shift = 0;  // cells are 1 << _shift units wide
+    int32_t              _size  = 0;  // and the grid is _size cells on a side
+    std::vector<int32_t> _cells;      // _entries[_cells[c] .. _cells[c + 1]) are in cell c
+    std::vector<Entry>   _entries;    // grouped by cell
+    std::vector<int32_t> _order;      // index in g.root order of each of _entries
+    std::vector<int32_t> _order_of;   // index in g.root order of each object number, or -1
+    std::vector<int32_t> _scratch;    // reused by build()
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_TARGET_INDEX_HPP_
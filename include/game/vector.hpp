@@ -23,6 +23,7 @@
 
 #include "data/base-object.hpp"
 #include "data/handle.hpp"
+#include "game/slot-allocator.hpp"
 #include "math/geometry.hpp"
 
 namespace antares {
@@ -32,9 +33,10 @@ class SpaceObject;
 static const int kBoltPointNum = 10;
 
 struct Vector {
-    static Vector*            get(int number);
-    static Handle<Vector>     none() { return Handle<Vector>(-1); }
-    static HandleList<Vector> all() { return HandleList<Vector>(0, size); }
+    static Vector*                get(int number);
+    static Handle<Vector>         none() { return Handle<Vector>(-1); }
+    static HandleList<Vector>     all() { return HandleList<Vector>(0, size); }
+    static UsedHandleList<Vector> live();  // Only the vectors in use.
 
     Vector();
 
@@ -61,13 +63,13 @@ struct Vector {
 
   private:
     friend class Vectors;
-    const static size_t size = 256;
+    static size_t size;
 };
 
 class Vectors {
   public:
     static void           init();
-    static void           reset();
+    static void           reset(int32_t object_capacity);
     static Handle<Vector> add(Point* location, const BaseObject::Ray& r);
     static Handle<Vector> add(Point* location, const BaseObject::Bolt& b);
     static void set_attributes(Handle<SpaceObject> vectorObject, Handle<SpaceObject> sourceObject);
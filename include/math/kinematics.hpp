@@ -0,0 +1,65 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_MATH_KINEMATICS_HPP_
+#define ANTARES_MATH_KINEMATICS_HPP_
+
+#include <stdint.h>
+
+#include "math/fixed.hpp"
+
+namespace antares {
+
+// Adds velocity to *fraction, then moves the nearest whole number out of it and returns that
+// number. This is the step that moves objects and stars, and turns objects.
+inline int32_t carry_fraction(Fixed velocity, Fixed* fraction) {
+    *fraction += velocity;
+    int32_t h;
+    if (*fraction >= Fixed::zero()) {
+        h = more_evil_fixed_to_long(*fraction + Fixed::from_float(0.5));
+    } else {
+        h = more_evil_fixed_to_long(*fraction - Fixed::from_float(0.5)) + 1;
+    }
+    *fraction -= Fixed::from_long(h);
+    return h;
+}
+
+// For each i < n, does carry_fraction(velocity[i], &fraction[i]), but leaves the remainder in
+// out_fraction[i] (which may be fraction itself) and the whole number in whole[i]. It uses the
+// widest kernel that the CPU supports, so it's meant for batches; for one or two values, call
+// carry_fraction() instead.
+void carry_fractions(
+        int32_t n, const Fixed* velocity, const Fixed* fraction, Fixed* out_fraction,
+        int32_t* whole);
+
+enum class CarryKernel {
+    SCALAR,
+    SSE2,
+    AVX2,
+};
+
+bool        carry_kernel_supported(CarryKernel kernel);
+CarryKernel best_carry_kernel();
+
+// As above, but with a specific kernel, which must be supported.
+void carry_fractions(
+        CarryKernel kernel, int32_t n, const Fixed* velocity, const Fixed* fraction,
+        Fixed* out_fraction, int32_t* whole);
+
+}  // namespace antares
+
+#endif  // ANTARES_MATH_KINEMATICS_HPP_
@@ -25,6 +25,7 @@
 #include "math/units.hpp"
 #include "ui/card.hpp"
 #include "ui/event.hpp"
+#include "video/driver.hpp"
 
 namespace antares {
 
@@ -43,7 +44,15 @@ class EventScheduler {
     EventScheduler(const EventScheduler&) = delete;
     EventScheduler& operator=(const EventScheduler&) = delete;
 
+    // Takes a snapshot at tick `at`.
     void schedule_snapshot(int64_t at);
+    // Takes a snapshot every `stride` ticks from `start` on, until before `end`, if given.
+    void schedule_snapshots(int64_t start, int64_t stride);
+    void schedule_snapshots(int64_t start, int64_t stride, int64_t end);
+    // Takes a snapshot whenever the game reports `trigger`.
+    void snapshot_on(SnapshotTrigger trigger);
+    void trigger_snapshot(SnapshotTrigger trigger);
+
     void schedule_event(std::unique_ptr<Event> event);
     void schedule_key(Key key, int64_t down, int64_t up);
     void schedule_mouse(int button, const Point& where, int64_t down, int64_t up);
@@ -55,13 +64,23 @@ class EventScheduler {
     wall_time now() const { return wall_time(_ticks); }
 
   private:
+    struct Recurrence {
+        wall_ticks next;
+        ticks      stride;
+        wall_ticks end;
+    };
+
     void advance_tick_count(MainLoop& loop, wall_ticks ticks);
-    bool have_snapshots_before(wall_ticks ticks) const;
+    bool next_snapshot(wall_ticks* at) const;
+    void pop_snapshot(wall_ticks at);
 
     static bool is_later(const std::unique_ptr<Event>& x, const std::unique_ptr<Event>& y);
 
     wall_ticks                          _ticks;
     std::vector<wall_ticks>             _snapshot_times;
+    std::vector<Recurrence>             _snapshot_recurrences;
+    uint32_t                            _snapshot_triggers = 0;
+    bool                                _triggered         = false;
     std::vector<std::unique_ptr<Event>> _event_heap;
     Point                               _mouse;
 };
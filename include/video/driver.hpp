@@ -48,6 +48,12 @@ enum GameState {
     DONE_GAME,
 };
 
+// Things that happen during play that a snapshot might be wanted of.
+enum class SnapshotTrigger {
+    OBJECT_DESTROYED,
+    CONDITION_FIRED,
+};
+
 class VideoDriver {
   public:
     VideoDriver();
@@ -73,6 +79,15 @@ class VideoDriver {
     virtual void    draw_diamond(const Rect& rect, const RgbColor& color)                = 0;
     virtual void    draw_plus(const Rect& rect, const RgbColor& color)                   = 0;
 
+    // Creates a texture with an overlay, which is tinted when drawing as by
+    // PixMap::tint_overlay(). By default, tints on the CPU, the first time each hue is drawn.
+    virtual Texture hued_texture(
+            pn::string_view name, const PixMap& content, const PixMap& overlay, int scale);
+
+    // Called by the game when `trigger` happens. Drivers that take snapshots may take one of the
+    // next frame; by default, nothing happens.
+    virtual void trigger_snapshot(SnapshotTrigger trigger) {}
+
   private:
     friend class Points;
     friend class Lines;
@@ -118,6 +133,11 @@ class Texture {
         virtual void draw_quad(const Rect& dest, const Rect& source, const RgbColor& tint) const {
             draw_cropped(dest, source, tint);
         }
+        // `frame` names the image at `source`, for drivers that log what they draw.
+        virtual void draw_hued_quad(
+                const Rect& dest, const Rect& source, Hue hue, pn::string_view frame) const {
+            draw_quad(dest, source, RgbColor::white());
+        }
     };
 
     Texture(std::nullptr_t n = nullptr) {}
@@ -238,6 +258,7 @@ class Quads {
     Quads(const Texture& sprite);
     ~Quads();
     void draw(const Rect& dest, const Rect& source, const RgbColor& tint) const;
+    void draw(const Rect& dest, const Rect& source, Hue hue, pn::string_view frame) const;
 
   private:
     const Texture& _sprite;
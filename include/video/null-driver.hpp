@@ -0,0 +1,68 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_VIDEO_NULL_DRIVER_HPP_
+#define ANTARES_VIDEO_NULL_DRIVER_HPP_
+
+#include "video/driver.hpp"
+
+namespace antares {
+
+// A video driver that draws nothing and has no event loop. Textures are still created (with the
+// right sizes), so levels can be loaded and simulated, but nothing can be shown.
+//
+// The clock follows g.time, so that code which measures time with now() during the game sees
+// time pass at the same rate as it would under EventScheduler.
+class NullVideoDriver : public VideoDriver {
+  public:
+    NullVideoDriver(Size screen_size) : _size(screen_size) {}
+
+    virtual Point     get_mouse() { return Point(-1, -1); }
+    virtual InputMode input_mode() const { return KEYBOARD_MOUSE; }
+    virtual int       scale() const { return 1; }
+    virtual Size      screen_size() const { return _size; }
+
+    virtual bool start_editing(TextReceiver* text) { return false; }
+    virtual void stop_editing(TextReceiver* text) {}
+
+    virtual wall_time now() const;
+
+    virtual Texture texture(pn::string_view name, const PixMap& content, int scale);
+    virtual void    dither_rect(const Rect& rect, const RgbColor& color) {}
+    virtual void    draw_point(const Point& at, const RgbColor& color) {}
+    virtual void    draw_line(const Point& from, const Point& to, const RgbColor& color) {}
+    virtual void    draw_triangle(const Rect& rect, const RgbColor& color) {}
+    virtual void    draw_diamond(const Rect& rect, const RgbColor& color) {}
+    virtual void    draw_plus(const Rect& rect, const RgbColor& color) {}
+
+  private:
+    class TextureImpl;
+
+    virtual void batch_rect(const Rect& rect, const RgbColor& color) {}
+
+    const Size _size;
+};
+
+// Sets up globals, plugin data, and game state for a program that runs levels without showing
+// them, such as replay or object-stress. Preference, sound, and video drivers must already be
+// installed in `sys`.
+void init_headless_game();
+
+}  // namespace antares
+
+#endif  // ANTARES_VIDEO_NULL_DRIVER_HPP_
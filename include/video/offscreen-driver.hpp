@@ -19,6 +19,8 @@
 #ifndef ANTARES_VIDEO_OFFSCREEN_DRIVER_HPP_
 #define ANTARES_VIDEO_OFFSCREEN_DRIVER_HPP_
 
+#include <memory>
+#include <pn/output>
 #include <pn/string>
 #include <sfz/sfz.hpp>
 
@@ -30,9 +32,16 @@ namespace antares {
 
 class OffscreenVideoDriver : public OpenGlVideoDriver {
     class MainLoop;
+    class FrameWriter;
 
   public:
+    enum class FrameFormat {
+        Y4M,   // YUV4MPEG2, 4:4:4, as read by ffmpeg and most other encoders.
+        RGBA,  // Headerless; 4 bytes per pixel, top row first.
+    };
+
     OffscreenVideoDriver(Size screen_size, const sfz::optional<pn::string>& output_dir);
+    ~OffscreenVideoDriver();
 
     virtual Size viewport_size() const { return _screen_size; }
     virtual Size screen_size() const { return _screen_size; }
@@ -45,14 +54,33 @@ class OffscreenVideoDriver : public OpenGlVideoDriver {
 
     virtual wall_time now() const { return _scheduler->now(); }
 
+    // Tints on the CPU, so that screenshots match the reference images exactly.
+    virtual Texture hued_texture(
+            pn::string_view name, const PixMap& content, const PixMap& overlay, int scale) {
+        return VideoDriver::hued_texture(name, content, overlay, scale);
+    }
+
+    virtual void trigger_snapshot(SnapshotTrigger trigger) {
+        if (_scheduler) {
+            _scheduler->trigger_snapshot(trigger);
+        }
+    }
+
     void loop(Card* initial, EventScheduler& scheduler);
     void capture(std::vector<std::pair<std::unique_ptr<Card>, pn::string>>& pix);
     void set_capture_rect(Rect r) { _capture_rect = r; }
+    void set_print_draw_calls(bool print) { _print_draw_calls = print; }
+
+    // Writes snapshots to `out` as frames of raw video, instead of as PNG files in the output
+    // directory. Each frame lasts `ticks_per_frame`, for formats that record a frame rate.
+    void set_frame_output(pn::output_view out, FrameFormat format, int32_t ticks_per_frame);
 
   private:
-    const Size                _screen_size;
-    sfz::optional<pn::string> _output_dir;
-    Rect                      _capture_rect;
+    const Size                   _screen_size;
+    sfz::optional<pn::string>    _output_dir;
+    Rect                         _capture_rect;
+    bool                         _print_draw_calls = false;
+    std::unique_ptr<FrameWriter> _frames;
 
     EventScheduler* _scheduler = nullptr;
 };
@@ -21,6 +21,7 @@
 
 #include <stdint.h>
 #include <map>
+#include <vector>
 
 #include "drawing/color.hpp"
 #include "math/geometry.hpp"
@@ -57,6 +58,8 @@ class OpenGlVideoDriver : public VideoDriver {
     virtual int scale() const;
 
     virtual Texture texture(pn::string_view name, const PixMap& content, int scale);
+    virtual Texture hued_texture(
+            pn::string_view name, const PixMap& content, const PixMap& overlay, int scale);
     virtual void    dither_rect(const Rect& rect, const RgbColor& color);
     virtual void    draw_point(const Point& at, const RgbColor& color);
     virtual void    draw_line(const Point& from, const Point& to, const RgbColor& color);
@@ -64,6 +67,14 @@ class OpenGlVideoDriver : public VideoDriver {
     virtual void    draw_diamond(const Rect& rect, const RgbColor& color);
     virtual void    draw_plus(const Rect& rect, const RgbColor& color);
 
+    struct FrameStats {
+        int32_t draw_calls     = 0;
+        int64_t bytes_uploaded = 0;
+    };
+
+    // Draw calls made, and vertex data uploaded, while drawing the last frame.
+    const FrameStats& frame_stats() const { return _last_frame_stats; }
+
     struct Uniforms {
         Uniform<vec2>          screen          = {"screen"};
         Uniform<int>           scale           = {"scale"};
@@ -74,6 +85,35 @@ class OpenGlVideoDriver : public VideoDriver {
         Uniform<vec2>          unit            = {"unit"};
         Uniform<vec4>          outline_color   = {"outline_color"};
         Uniform<int>           seed            = {"seed"};
+        Uniform<sampler2DRect> overlay         = {"overlay"};
+        Uniform<sampler2D>     tints           = {"tints"};
+    };
+
+    // Collects vertices until flushed, then uploads and draws them with a single call.
+    class Stream {
+      public:
+        void init();
+        void begin(uint32_t mode);
+        void add(
+                float x, float y, const RgbColor& color, int16_t u = 0, int16_t v = 0,
+                uint8_t hue = 0);
+        void flush();
+
+        FrameStats stats;
+
+      private:
+        struct Vertex {
+            float   x, y;
+            uint8_t color[4];
+            int16_t u, v;
+            uint8_t hue;
+        };
+
+        uint32_t            _buffer   = 0;
+        uint32_t            _mode     = 0;
+        size_t              _capacity = 0;
+        size_t              _offset   = 0;
+        std::vector<Vertex> _vertices;
     };
 
   protected:
@@ -82,6 +122,7 @@ class OpenGlVideoDriver : public VideoDriver {
         MainLoop(OpenGlVideoDriver& driver, Card* initial);
         MainLoop(const MainLoop&) = delete;
         MainLoop& operator=(const MainLoop&) = delete;
+        ~MainLoop();
 
         void  draw();
         bool  done() const;
@@ -114,12 +155,13 @@ class OpenGlVideoDriver : public VideoDriver {
     Random _static_seed;
 
     Uniforms _uniforms;
+    Stream   _stream;
 
     std::map<size_t, Texture> _triangles;
     std::map<size_t, Texture> _diamonds;
     std::map<size_t, Texture> _pluses;
 
-    uint32_t _vbuf[3];
+    FrameStats _last_frame_stats;
 };
 
 }  // namespace antares
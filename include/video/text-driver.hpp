@@ -50,6 +50,16 @@ class TextVideoDriver : public VideoDriver {
     virtual void    draw_diamond(const Rect& rect, const RgbColor& color);
     virtual void    draw_plus(const Rect& rect, const RgbColor& color);
 
+    // Nothing is rendered, so there's nothing to tint: hued draws are logged like any other.
+    virtual Texture hued_texture(
+            pn::string_view name, const PixMap& content, const PixMap& overlay, int scale);
+
+    virtual void trigger_snapshot(SnapshotTrigger trigger) {
+        if (_scheduler) {
+            _scheduler->trigger_snapshot(trigger);
+        }
+    }
+
     void loop(Card* initial, EventScheduler& scheduler);
     void capture(std::vector<std::pair<std::unique_ptr<Card>, pn::string>>& pix);
 
@@ -23,9 +23,15 @@ FAILED = "FAILED"
 EXCEPT = "EXCEPT"
 
 WINE_TESTS = [
+    "admiral-test",
     "color-test",
     "editable-text-test",
     "fixed-test",
+    "kinematics-test",
+    "replay-test",
+    "slot-allocator-test",
+    "state-hash-test",
+    "target-index-test",
 ]
 
 
@@ -80,6 +86,26 @@ def replay_test(opts, queue, name, args=[]):
     return diff_test(queue, name, cmd + args, expected)
 
 
+def planner_test(opts, queue, name, replay):
+    # The planner must be deterministic, and must actually change how the computer plays.
+    cmd = ["out/cur/replay", "test/%s.NLRP" % replay, "--sim-only"]
+    with NamedTemporaryDir() as d:
+        legacy, a, b = ["%s/%s.hashes" % (d, ai) for ai in ["legacy", "a", "b"]]
+        if not (run(queue, name, cmd + ["--state-hashes=%s" % legacy])
+                and run(queue, name, cmd + ["--ai=planner", "--state-hashes=%s" % a])
+                and run(queue, name, cmd + ["--ai=planner", "--state-hashes=%s" % b])
+                and run(queue, name, ["out/cur/diff-state-hashes", a, b])):
+            return False
+        # Here, a nonzero exit (divergence) is the expected outcome, so don't use run().
+        sub = subprocess.Popen(["out/cur/diff-state-hashes", legacy, a],
+                               stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        output, _ = sub.communicate()
+        if sub.returncode == 0:
+            print("planner did not change %s:\n%s" % (replay, output))
+            return False
+        return True
+
+
 def call(args):
     fn = args[0]
     opts = args[1]
@@ -121,7 +147,7 @@ def main():
         print("test data submodule is missing; fetching it")
         subprocess.check_call("git submodule update --init test".split())
 
-    test_types = "unit data offscreen replay".split()
+    test_types = "unit data offscreen replay planner".split()
     parser = argparse.ArgumentParser()
     parser.add_argument("--smoke", action="store_true")
     parser.add_argument("--wine", action="store_true")
@@ -132,9 +158,15 @@ def main():
     queue = multiprocessing.Queue()
     pool = multiprocessing.pool.ThreadPool()
     tests = [
+        (unit_test, opts, queue, "admiral-test"),
         (unit_test, opts, queue, "color-test"),
         (unit_test, opts, queue, "editable-text-test"),
         (unit_test, opts, queue, "fixed-test"),
+        (unit_test, opts, queue, "kinematics-test"),
+        (unit_test, opts, queue, "replay-test"),
+        (unit_test, opts, queue, "slot-allocator-test"),
+        (unit_test, opts, queue, "state-hash-test"),
+        (unit_test, opts, queue, "target-index-test"),
         (data_test, opts, queue, "build-pix", [], ["--text"]),
         (data_test, opts, queue, "object-data"),
         (data_test, opts, queue, "shapes"),
@@ -160,6 +192,9 @@ def main():
         (replay_test, opts, queue, "while-the-iron-is-hot"),
         (replay_test, opts, queue, "yo-ho-ho"),
         (replay_test, opts, queue, "you-should-have-seen-the-one-that-got-away"),
+        (planner_test, opts, queue, "hornets-nest-planner", "hornets-nest"),
+        (planner_test, opts, queue, "the-mothership-connection-planner",
+         "the-mothership-connection"),
     ]
 
     if opts.test:
@@ -175,6 +210,8 @@ def main():
             tests = [t for t in tests if t[0] != offscreen_test]
         if "replay" not in opts.type:
             tests = [t for t in tests if t[0] != replay_test]
+        if "planner" not in opts.type:
+            tests = [t for t in tests if t[0] != planner_test]
 
     if opts.wine:
         tests = [t for t in tests if t[3] in WINE_TESTS]
@@ -0,0 +1,109 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+#include <pn/output>
+#include <sfz/sfz.hpp>
+
+#include "game/state-hash.hpp"
+#include "lang/exception.hpp"
+
+namespace args = sfz::args;
+
+namespace antares {
+namespace {
+
+void usage(pn::output_view out, pn::string_view progname, int retcode) {
+    out.format(
+            "usage: {0} [OPTIONS] a b\n"
+            "\n"
+            "  Compares two state hash files, as written by replay --state-hashes, and\n"
+            "  reports the first tick where they diverge, which parts of the state differ,\n"
+            "  and, if both files have a dump of that tick, the first field that differs\n"
+            "\n"
+            "  arguments:\n"
+            "    a, b                state hash files to compare\n"
+            "\n"
+            "  options:\n"
+            "    -h, --help          display this help screen\n",
+            progname);
+    exit(retcode);
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    std::vector<pn::string> paths;
+    callbacks.argument = [&paths](pn::string_view arg) {
+        if (paths.size() < 2) {
+            paths.push_back(arg.copy());
+        } else {
+            return false;
+        }
+        return true;
+    };
+
+    callbacks.short_option = [&argv](pn::rune opt, const args::callbacks::get_value_f& get_value) {
+        switch (opt.value()) {
+            case 'h': usage(pn::out, sfz::path::basename(argv[0]), 0); return true;
+            default: return false;
+        }
+    };
+
+    callbacks.long_option =
+            [&callbacks](pn::string_view opt, const args::callbacks::get_value_f& get_value) {
+                if (opt == "help") {
+                    return callbacks.short_option(pn::rune{'h'}, get_value);
+                } else {
+                    return false;
+                }
+            };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if (paths.size() < 2) {
+        throw std::runtime_error("missing required arguments 'a' and 'b'");
+    }
+
+    sfz::mapped_file a_file(paths[0]), b_file(paths[1]);
+    StateDivergence  d = diff_state_logs(a_file.data().input(), b_file.data().input());
+    switch (d.result) {
+        case StateDivergence::NONE:
+            pn::out.format("no divergence in {0} ticks\n", d.ticks);
+            return;
+
+        case StateDivergence::LENGTH:
+        case StateDivergence::TICK: pn::out.format("{0}\n", d.detail); break;
+
+        case StateDivergence::STATE:
+            pn::out.format("first divergence at tick {0}\n", d.tick);
+            for (StateRecord::Kind kind : d.kinds) {
+                pn::out.format("  {0} state differs\n", state_kind_name(kind));
+            }
+            if (d.dumped) {
+                pn::out.format("  {0}\n", d.detail);
+            } else {
+                pn::out.format(
+                        "  no dump at tick {0}; replay with --state-dump-from={0} for fields\n",
+                        d.tick);
+            }
+            break;
+    }
+    exit(1);
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
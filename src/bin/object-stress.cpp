@@ -0,0 +1,200 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+
+#include "config/ledger.hpp"
+#include "config/preferences.hpp"
+#include "data/plugin.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/input-source.hpp"
+#include "game/level.hpp"
+#include "game/main.hpp"
+#include "game/space-object.hpp"
+#include "game/sys.hpp"
+#include "lang/exception.hpp"
+#include "sound/driver.hpp"
+#include "video/null-driver.hpp"
+
+namespace args = sfz::args;
+
+namespace antares {
+namespace {
+
+// Objects are spawned within this distance of an existing object, in each direction.
+const int16_t kSpawnSpread = 8192;
+
+// Input that never presses anything, and never ends the game.
+class IdleInputSource : public InputSource {
+  public:
+    virtual void start() {}
+    virtual bool get(Handle<Admiral> admiral, game_ticks at, EventReceiver& key_map) {
+        return true;
+    }
+};
+
+const Level& find_level(int chapter) {
+    for (auto& kv : plug.levels) {
+        if (kv.second.base.chapter.value_or(-1) == chapter) {
+            return kv.second;
+        }
+    }
+    throw std::runtime_error(pn::format("no chapter {0}", chapter).c_str());
+}
+
+// Fills the level up to `count` objects with copies of the ships already in it, scattered
+// around the originals, so that the copies fight, collide, and think like the originals do.
+void spawn(int count) {
+    std::vector<Handle<SpaceObject>> originals;
+    for (auto o : SpaceObject::all()) {
+        if ((o->active == kObjectInUse) && (o->attributes & kCanThink)) {
+            originals.push_back(o);
+        }
+    }
+    if (originals.empty()) {
+        throw std::runtime_error("level has no ships to copy");
+    }
+
+    for (int i = 0; g.object_slots.used() < count; ++i) {
+        auto           original = originals[i % originals.size()];
+        Point          where    = original->location;
+        fixedPointType velocity = {Fixed::zero(), Fixed::zero()};
+        where.offset(
+                g.random.next(2 * kSpawnSpread) - kSpawnSpread,
+                g.random.next(2 * kSpawnSpread) - kSpawnSpread);
+        auto copy = CreateAnySpaceObject(
+                *original->base, &velocity, &where, original->direction, original->owner, 0,
+                sfz::nullopt);
+        if (!copy.get()) {
+            throw std::runtime_error(pn::format("failed to spawn object {0}", i).c_str());
+        }
+    }
+}
+
+// Plays `chapter` with about `count` objects for `duration` and prints the average tick time.
+void stress(int chapter, int count, ticks duration) {
+    const Level&    level = find_level(chapter);
+    IdleInputSource input;
+    SimSeeker       seeker(level, &input, ticks(0), std::max(2 * count, kMaxSpaceObject));
+    spawn(count);
+
+    using std::chrono::steady_clock;
+    game_ticks start      = g.time;
+    auto       wall_start = steady_clock::now();
+    seeker.seek(start + duration);
+    std::chrono::duration<double, std::micro> wall_time = steady_clock::now() - wall_start;
+
+    int64_t ticks_run = (g.time - start).count();
+    char    per_tick[32];
+    snprintf(
+            per_tick, sizeof(per_tick), "%.1f",
+            ticks_run ? (wall_time.count() / ticks_run) : 0.0);
+    pn::out.format(
+            "{0}\t{1}\t{2}\t{3}\n", count, g.object_slots.used(), ticks_run,
+            pn::string_view{per_tick});
+}
+
+void usage(pn::output_view out, pn::string_view progname, int retcode) {
+    out.format(
+            "usage: {0} [OPTIONS] count...\n"
+            "\n"
+            "  Plays a level without drawing, filled up with copies of its ships, and prints\n"
+            "  the object count, the objects left at the end, the ticks simulated, and the\n"
+            "  average microseconds per tick, one line per count\n"
+            "\n"
+            "  arguments:\n"
+            "    count               number of objects to fill the level up to\n"
+            "\n"
+            "  options:\n"
+            "    -l, --level=CHAPTER level to play (default: 1)\n"
+            "    -t, --ticks=TICKS   ticks to simulate for each count (default: 3600)\n"
+            "        --help          display this help screen\n",
+            progname);
+    exit(retcode);
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    std::vector<int> counts;
+    callbacks.argument = [&counts](pn::string_view arg) {
+        int count;
+        sfz::args::integer_option(arg, &count);
+        counts.push_back(count);
+        return true;
+    };
+
+    int chapter            = 1;
+    int duration           = 3600;
+    callbacks.short_option = [&chapter, &duration](
+                                     pn::rune opt, const args::callbacks::get_value_f& get_value) {
+        switch (opt.value()) {
+            case 'l': sfz::args::integer_option(get_value(), &chapter); return true;
+            case 't': sfz::args::integer_option(get_value(), &duration); return true;
+            default: return false;
+        }
+    };
+
+    callbacks.long_option = [&argv, &callbacks](
+                                    pn::string_view                     opt,
+                                    const args::callbacks::get_value_f& get_value) {
+        if (opt == "level") {
+            return callbacks.short_option(pn::rune{'l'}, get_value);
+        } else if (opt == "ticks") {
+            return callbacks.short_option(pn::rune{'t'}, get_value);
+        } else if (opt == "help") {
+            usage(pn::out, sfz::path::basename(argv[0]), 0);
+            return true;
+        } else {
+            return false;
+        }
+    };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if (counts.empty()) {
+        throw std::runtime_error("missing required argument 'count'");
+    }
+    for (int count : counts) {
+        if ((count < 1) || ((2 * count) > kObjectCapacityLimit)) {
+            throw std::runtime_error(pn::format(
+                                             "count must be between 1 and {0} (was {1})",
+                                             kObjectCapacityLimit / 2, count)
+                                             .c_str());
+        }
+    }
+
+    Preferences     preferences;
+    NullPrefsDriver prefs(preferences.copy());
+    NullSoundDriver sound;
+    NullLedger      ledger;
+    NullVideoDriver video({640, 480});
+    init_headless_game();
+
+    for (int count : counts) {
+        stress(chapter, count, ticks(duration));
+    }
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
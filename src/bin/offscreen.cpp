@@ -62,6 +62,7 @@ void usage(pn::output_view out, pn::string_view progname, int retcode) {
             "options:\n"
             " -o, --output=OUTPUT place output in this directory\n"
             " -t, --text          produce text output\n"
+            " -d, --draw-calls    print draw calls and bytes uploaded in each frame\n"
             " -h, --help          display this help screen\n",
             progname);
     exit(retcode);
@@ -81,12 +82,15 @@ void main(int argc, char* const* argv) {
     };
 
     sfz::optional<pn::string> output_dir;
-    bool                      text = false;
-    callbacks.short_option         = [&argv, &output_dir, &text](
-                                     pn::rune opt, const args::callbacks::get_value_f& get_value) {
+    bool                      text       = false;
+    bool                      draw_calls = false;
+
+    callbacks.short_option = [&argv, &output_dir, &text, &draw_calls](
+                             pn::rune opt, const args::callbacks::get_value_f& get_value) {
         switch (opt.value()) {
             case 'o': output_dir.emplace(get_value().copy()); return true;
             case 't': text = true; return true;
+            case 'd': draw_calls = true; return true;
             case 'h': usage(pn::out, sfz::path::basename(argv[0]), 0); return true;
             default: return false;
         }
@@ -98,6 +102,8 @@ void main(int argc, char* const* argv) {
                     return callbacks.short_option(pn::rune{'o'}, get_value);
                 } else if (opt == "text") {
                     return callbacks.short_option(pn::rune{'t'}, get_value);
+                } else if (opt == "draw-calls") {
+                    return callbacks.short_option(pn::rune{'d'}, get_value);
                 } else if (opt == "help") {
                     return callbacks.short_option(pn::rune{'h'}, get_value);
                 } else {
@@ -144,6 +150,7 @@ void main(int argc, char* const* argv) {
         video.loop(new Master(14586), scheduler);
     } else {
         OffscreenVideoDriver video({640, 480}, output_dir);
+        video.set_print_draw_calls(draw_calls);
         video.loop(new Master(14586), scheduler);
     }
 }
@@ -172,9 +179,7 @@ void fast_motion(EventScheduler& scheduler) {
 
     scheduler.schedule_key(Key::N5, 2020, 2400);
     scheduler.schedule_key(Key::F6, 2020, 2400);
-    for (int i = 2200; i < 2290; i += 10) {
-        scheduler.schedule_snapshot(i);
-    }
+    scheduler.schedule_snapshots(2200, 10, 2290);
 
     scheduler.schedule_snapshot(2400);
 
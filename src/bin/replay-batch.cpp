@@ -0,0 +1,266 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+
+#include "config/ledger.hpp"
+#include "config/preferences.hpp"
+#include "data/plugin.hpp"
+#include "data/replay.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/input-source.hpp"
+#include "game/level.hpp"
+#include "game/main.hpp"
+#include "game/space-object.hpp"
+#include "game/sys.hpp"
+#include "lang/exception.hpp"
+#include "math/random.hpp"
+#include "sound/driver.hpp"
+#include "ui/screens/debriefing.hpp"
+#include "video/null-driver.hpp"
+
+namespace args = sfz::args;
+
+namespace antares {
+namespace {
+
+pn::string json_string(pn::string_view s) {
+    pn::string result = "\"";
+    for (pn::rune r : s) {
+        switch (r.value()) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\t': result += "\\t"; break;
+            default:
+                if (r.value() < 0x20) {
+                    char escaped[7];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", r.value());
+                    result += escaped;
+                } else {
+                    result += r;
+                }
+                break;
+        }
+    }
+    result += "\"";
+    return result;
+}
+
+// Runs one replay to completion and returns its result as one line of JSON.
+pn::string run_replay(pn::string_view path) {
+    using std::chrono::steady_clock;
+    auto start = steady_clock::now();
+
+    sfz::mapped_file  replay_file(path);
+    ReplayData        replay_data(replay_file.data());
+    ReplayInputSource input_source(&replay_data);
+
+    Randomize(4);  // For the decision to replay intro.
+    g.random.seed = replay_data.global_seed;
+    GameResult game_result = play_sim_only(*Level::get(replay_data.chapter_id), &input_source);
+
+    std::chrono::duration<double> wall_time = steady_clock::now() - start;
+
+    char sync[9];
+    snprintf(sync, sizeof(sync), "%08x", g.sync);
+    char seconds[32];
+    snprintf(seconds, sizeof(seconds), "%.3f", wall_time.count());
+    pn::string score = "null";
+    if ((game_result == WIN_GAME) && (g.level->type() == Level::Type::SOLO)) {
+        Handle<Admiral> player(0);
+        score = pn::dump(
+                DebriefingScreen::score(
+                        g.time, g.level->solo.par.time, GetAdmiralLoss(player),
+                        g.level->solo.par.losses, GetAdmiralKill(player),
+                        g.level->solo.par.kills),
+                pn::dump_short);
+    }
+    return pn::format(
+            "{{\"replay\": {0}, \"outcome\": \"{1}\", \"duration\": {2}, \"sync\": \"{3}\", "
+            "\"score\": {4}, \"wall_time\": {5}}}\n",
+            json_string(path), (game_result == WIN_GAME) ? "win" : "loss",
+            g.time.time_since_epoch().count(), pn::string_view{sync}, score,
+            pn::string_view{seconds});
+}
+
+pn::string error_line(pn::string_view path, pn::string_view message) {
+    return pn::format(
+            "{{\"replay\": {0}, \"error\": {1}}}\n", json_string(path), json_string(message));
+}
+
+// Writes `line` with a single write(2), so that lines from different workers don’t interleave.
+// The output file is opened with O_APPEND, and lines are much shorter than PIPE_BUF, so this
+// holds for both regular files and pipes.
+void write_line(int fd, pn::string_view line) {
+    if (write(fd, line.data(), line.size()) != static_cast<ssize_t>(line.size())) {
+        throw std::runtime_error(pn::format("write: {0}", strerror(errno)).c_str());
+    }
+}
+
+// Worker loop: claims replays from the shared `next` index until none remain.
+void work(const std::vector<pn::string>& replays, std::atomic<int>* next, int out_fd) {
+    while (true) {
+        int i = (*next)++;
+        if (i >= replays.size()) {
+            return;
+        }
+        try {
+            write_line(out_fd, run_replay(replays[i]));
+        } catch (std::exception& e) {
+            write_line(out_fd, error_line(replays[i], e.what()));
+        }
+    }
+}
+
+void usage(pn::output_view out, pn::string_view progname, int retcode) {
+    out.format(
+            "usage: {0} [OPTIONS] replay...\n"
+            "\n"
+            "  Simulates many replays in parallel, without drawing, and writes one line\n"
+            "  of JSON per replay with its outcome, duration, final sync, and wall time\n"
+            "\n"
+            "  arguments:\n"
+            "    replay              an Antares replay script\n"
+            "\n"
+            "  options:\n"
+            "    -o, --output=FILE   append results to this file (default: stdout)\n"
+            "    -j, --jobs=JOBS     number of worker processes (default: one per CPU)\n"
+            "    -w, --width=WIDTH   screen width (default: 640)\n"
+            "    -h, --height=HEIGHT screen height (default: 480)\n"
+            "        --help          display this help screen\n",
+            progname);
+    exit(retcode);
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    std::vector<pn::string> replays;
+    callbacks.argument = [&replays](pn::string_view arg) {
+        replays.push_back(arg.copy());
+        return true;
+    };
+
+    sfz::optional<pn::string> output_path;
+    int                       jobs   = sysconf(_SC_NPROCESSORS_ONLN);
+    int                       width  = 640;
+    int                       height = 480;
+    callbacks.short_option           = [&output_path, &jobs, &width, &height](
+                                     pn::rune opt, const args::callbacks::get_value_f& get_value) {
+        switch (opt.value()) {
+            case 'o': output_path.emplace(get_value().copy()); return true;
+            case 'j': sfz::args::integer_option(get_value(), &jobs); return true;
+            case 'w': sfz::args::integer_option(get_value(), &width); return true;
+            case 'h': sfz::args::integer_option(get_value(), &height); return true;
+            default: return false;
+        }
+    };
+
+    callbacks.long_option = [&argv, &callbacks](
+                                    pn::string_view                     opt,
+                                    const args::callbacks::get_value_f& get_value) {
+        if (opt == "output") {
+            return callbacks.short_option(pn::rune{'o'}, get_value);
+        } else if (opt == "jobs") {
+            return callbacks.short_option(pn::rune{'j'}, get_value);
+        } else if (opt == "width") {
+            return callbacks.short_option(pn::rune{'w'}, get_value);
+        } else if (opt == "height") {
+            return callbacks.short_option(pn::rune{'h'}, get_value);
+        } else if (opt == "help") {
+            usage(pn::out, sfz::path::basename(argv[0]), 0);
+            return true;
+        } else {
+            return false;
+        }
+    };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if (replays.empty()) {
+        throw std::runtime_error("missing required argument 'replay'");
+    }
+    jobs = std::max(1, std::min<int>(jobs, replays.size()));
+
+    int out_fd = STDOUT_FILENO;
+    if (output_path.has_value()) {
+        out_fd = open(output_path->c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (out_fd < 0) {
+            throw std::runtime_error(
+                    pn::format("{0}: {1}", *output_path, strerror(errno)).c_str());
+        }
+    }
+
+    Preferences preferences;
+    preferences.play_music_in_game = true;
+    NullPrefsDriver prefs(preferences.copy());
+    NullSoundDriver sound;
+    NullLedger      ledger;
+    NullVideoDriver video({width, height});
+
+    // Load everything that doesn’t depend on the level once, before forking, so that workers
+    // share it copy-on-write instead of each paying for it.
+    init_headless_game();
+
+    void* shared = mmap(
+            nullptr, sizeof(std::atomic<int>), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+            -1, 0);
+    if (shared == MAP_FAILED) {
+        throw std::runtime_error(pn::format("mmap: {0}", strerror(errno)).c_str());
+    }
+    std::atomic<int>* next = new (shared) std::atomic<int>(0);
+
+    std::vector<pid_t> workers;
+    for (int i = 0; i < jobs; ++i) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            throw std::runtime_error(pn::format("fork: {0}", strerror(errno)).c_str());
+        } else if (pid == 0) {
+            work(replays, next, out_fd);
+            _exit(0);
+        }
+        workers.push_back(pid);
+    }
+
+    bool ok = true;
+    for (pid_t pid : workers) {
+        int status;
+        if ((waitpid(pid, &status, 0) < 0) || !WIFEXITED(status) || WEXITSTATUS(status)) {
+            pn::err.format("replay-batch: worker {0} failed\n", pid);
+            ok = false;
+        }
+    }
+    if (!ok) {
+        exit(1);
+    }
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
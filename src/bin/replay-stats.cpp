@@ -0,0 +1,277 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+
+#include "config/ledger.hpp"
+#include "config/preferences.hpp"
+#include "data/plugin.hpp"
+#include "data/replay.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/input-source.hpp"
+#include "game/level.hpp"
+#include "game/main.hpp"
+#include "game/sim-stats.hpp"
+#include "game/space-object.hpp"
+#include "game/sys.hpp"
+#include "lang/exception.hpp"
+#include "math/random.hpp"
+#include "sound/driver.hpp"
+#include "ui/screens/debriefing.hpp"
+#include "video/null-driver.hpp"
+
+namespace args = sfz::args;
+namespace path = sfz::path;
+
+namespace antares {
+namespace {
+
+pn::string json_string(pn::string_view s) {
+    pn::string result = "\"";
+    for (pn::rune r : s) {
+        switch (r.value()) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\t': result += "\\t"; break;
+            default:
+                if (r.value() < 0x20) {
+                    char escaped[7];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", r.value());
+                    result += escaped;
+                } else {
+                    result += r;
+                }
+                break;
+        }
+    }
+    result += "\"";
+    return result;
+}
+
+pn::string json_number(double d) {
+    char s[32];
+    snprintf(s, sizeof(s), "%.1f", d);
+    return s;
+}
+
+// Adds up the results of several replays. Peaks and capacities take the maximum, so that the
+// aggregate shows the worst case; everything else is summed.
+struct Totals {
+    int64_t  replays = 0;
+    int64_t  errors  = 0;
+    int64_t  ticks   = 0;
+    double   seconds = 0;
+    SimStats stats;
+
+    void add(const SimStats& s, int64_t t, double secs) {
+        ++replays;
+        ticks += t;
+        seconds += secs;
+        stats.major_ticks += s.major_ticks;
+        add(&stats.objects, s.objects);
+        add(&stats.sprites, s.sprites);
+        add(&stats.labels, s.labels);
+        add(&stats.vectors, s.vectors);
+        add(&stats.actions, s.actions);
+    }
+
+    static void add(SimStats::Pool* total, const SimStats::Pool& p) {
+        if (p.capacity.has_value()) {
+            total->capacity = std::max(total->capacity.value_or(0), *p.capacity);
+        }
+        total->peak = std::max(total->peak, p.peak);
+        total->dropped += p.dropped;
+    }
+};
+
+// An unbounded pool has a null capacity.
+pn::string pool_json(const SimStats::Pool& p) {
+    pn::string capacity = p.capacity.has_value() ? pn::dump(*p.capacity, pn::dump_short)
+                                                 : pn::string("null");
+    return pn::format(
+            "{{\"peak\": {0}, \"capacity\": {1}, \"dropped\": {2}}}", p.peak, capacity,
+            p.dropped);
+}
+
+pn::string stats_json(const SimStats& s, int64_t ticks, double seconds) {
+    return pn::format(
+            "\"ticks\": {0}, \"seconds\": {1}, \"ticks_per_second\": {2}, \"objects\": {3}, "
+            "\"sprites\": {4}, \"labels\": {5}, \"vectors\": {6}, \"actions\": {7}",
+            ticks, json_number(seconds), json_number(seconds ? (ticks / seconds) : 0),
+            pool_json(s.objects), pool_json(s.sprites), pool_json(s.labels),
+            pool_json(s.vectors), pool_json(s.actions));
+}
+
+// Runs one replay to completion, measuring it, and returns its result as one line of JSON.
+pn::string run_replay(pn::string_view path, Totals* totals) {
+    using std::chrono::steady_clock;
+
+    sfz::mapped_file  replay_file(path);
+    ReplayData        replay_data(replay_file.data());
+    ReplayInputSource input_source(&replay_data);
+
+    SimStats stats;
+    sys.sim_stats = &stats;
+    auto start    = steady_clock::now();
+
+    Randomize(4);  // For the decision to replay intro.
+    g.random.seed = replay_data.global_seed;
+    GameResult game_result = play_sim_only(*Level::get(replay_data.chapter_id), &input_source);
+
+    std::chrono::duration<double> wall_time = steady_clock::now() - start;
+    sys.sim_stats                           = nullptr;
+
+    int64_t ticks = g.time.time_since_epoch().count();
+    totals->add(stats, ticks, wall_time.count());
+    return pn::format(
+            "{{\"replay\": {0}, \"outcome\": \"{1}\", {2}}}\n", json_string(path),
+            (game_result == WIN_GAME) ? "win" : "loss",
+            stats_json(stats, ticks, wall_time.count()));
+}
+
+pn::string error_line(pn::string_view path, pn::string_view message) {
+    return pn::format(
+            "{{\"replay\": {0}, \"error\": {1}}}\n", json_string(path), json_string(message));
+}
+
+// Expands each directory in `paths` into the regular files it contains, in sorted order. Other
+// arguments are taken to be replays themselves.
+std::vector<pn::string> find_replays(const std::vector<pn::string>& paths) {
+    std::vector<pn::string> replays;
+    for (const auto& arg : paths) {
+        if (!path::isdir(arg)) {
+            replays.push_back(arg.copy());
+            continue;
+        }
+        std::vector<pn::string> names;
+        for (const auto& ent : sfz::scandir(arg)) {
+            pn::string_view name{ent.name};
+            if (name.empty() || (name.substr(0, 1) == ".")) {
+                continue;
+            }
+            pn::string replay = path::join(arg, name);
+            if (path::isfile(replay)) {
+                names.push_back(std::move(replay));
+            }
+        }
+        std::sort(names.begin(), names.end());
+        for (auto& name : names) {
+            replays.push_back(std::move(name));
+        }
+    }
+    return replays;
+}
+
+void usage(pn::output_view out, pn::string_view progname, int retcode) {
+    out.format(
+            "usage: {0} [OPTIONS] replay...\n"
+            "\n"
+            "  Simulates replays without drawing, and writes one line of JSON per replay\n"
+            "  with its speed and how close it came to each fixed limit: peak space\n"
+            "  objects, sprites, labels, vectors, and delayed actions in use, and how\n"
+            "  often each had to be dropped because none were free. The delayed-action\n"
+            "  queue is unbounded, so its capacity is null. A final line with key\n"
+            "  \"total\" aggregates them.\n"
+            "\n"
+            "  arguments:\n"
+            "    replay              an Antares replay script, or a directory of them\n"
+            "\n"
+            "  options:\n"
+            "    -w, --width=WIDTH   screen width (default: 640)\n"
+            "    -h, --height=HEIGHT screen height (default: 480)\n"
+            "        --help          display this help screen\n",
+            progname);
+    exit(retcode);
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    std::vector<pn::string> paths;
+    callbacks.argument = [&paths](pn::string_view arg) {
+        paths.push_back(arg.copy());
+        return true;
+    };
+
+    int width              = 640;
+    int height             = 480;
+    callbacks.short_option = [&width, &height](
+                               pn::rune opt, const args::callbacks::get_value_f& get_value) {
+        switch (opt.value()) {
+            case 'w': sfz::args::integer_option(get_value(), &width); return true;
+            case 'h': sfz::args::integer_option(get_value(), &height); return true;
+            default: return false;
+        }
+    };
+
+    callbacks.long_option = [&argv, &callbacks](
+                                    pn::string_view                     opt,
+                                    const args::callbacks::get_value_f& get_value) {
+        if (opt == "width") {
+            return callbacks.short_option(pn::rune{'w'}, get_value);
+        } else if (opt == "height") {
+            return callbacks.short_option(pn::rune{'h'}, get_value);
+        } else if (opt == "help") {
+            usage(pn::out, sfz::path::basename(argv[0]), 0);
+            return true;
+        } else {
+            return false;
+        }
+    };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if (paths.empty()) {
+        throw std::runtime_error("missing required argument 'replay'");
+    }
+    std::vector<pn::string> replays = find_replays(paths);
+
+    Preferences preferences;
+    preferences.play_music_in_game = true;
+    NullPrefsDriver prefs(preferences.copy());
+    NullSoundDriver sound;
+    NullLedger      ledger;
+    NullVideoDriver video({width, height});
+    init_headless_game();
+
+    Totals totals;
+    for (const auto& replay : replays) {
+        try {
+            pn::out.format("{0}", run_replay(replay, &totals));
+        } catch (std::exception& e) {
+            sys.sim_stats = nullptr;
+            ++totals.errors;
+            pn::out.format("{0}", error_line(replay, e.what()));
+        }
+    }
+    pn::out.format(
+            "{{\"total\": {{\"replays\": {0}, \"errors\": {1}, {2}}}}}\n", totals.replays,
+            totals.errors, stats_json(totals.stats, totals.ticks, totals.seconds));
+    if (totals.errors) {
+        exit(1);
+    }
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
@@ -18,11 +18,13 @@
 
 #include <fcntl.h>
 #include <getopt.h>
+#include <stdio.h>
 #include <pn/output>
 #include <sfz/sfz.hpp>
 
 #include "config/ledger.hpp"
 #include "config/preferences.hpp"
+#include "data/level.hpp"
 #include "data/plugin.hpp"
 #include "data/replay.hpp"
 #include "data/resource.hpp"
@@ -40,6 +42,7 @@
 #include "game/messages.hpp"
 #include "game/motion.hpp"
 #include "game/space-object.hpp"
+#include "game/state-hash.hpp"
 #include "game/sys.hpp"
 #include "game/vector.hpp"
 #include "lang/exception.hpp"
@@ -51,6 +54,7 @@
 #include "ui/interface-handling.hpp"
 #include "ui/screens/debriefing.hpp"
 #include "video/driver.hpp"
+#include "video/null-driver.hpp"
 #include "video/offscreen-driver.hpp"
 #include "video/text-driver.hpp"
 
@@ -62,6 +66,24 @@ namespace path = sfz::path;
 namespace antares {
 namespace {
 
+void write_debriefing(pn::string_view output_path, GameResult game_result) {
+    pn::string path = pn::format("{0}/debriefing.txt", output_path);
+    sfz::makedirs(path::dirname(path), 0755);
+    pn::output outcome{path, pn::text};
+    if (g.victory_text.has_value()) {
+        outcome.write(*g.victory_text);
+        if (game_result == WIN_GAME) {
+            outcome.write("\n");
+            Handle<Admiral> player(0);
+            pn::string      text = DebriefingScreen::build_score_text(
+                    g.time, g.level->solo.par.time, GetAdmiralLoss(player),
+                    g.level->solo.par.losses, GetAdmiralKill(player), g.level->solo.par.kills);
+            outcome.write(text);
+            outcome.write("\n");
+        }
+    }
+}
+
 class ReplayMaster : public Card {
   public:
     ReplayMaster(pn::data_view data, const sfz::optional<pn::string>& output_path)
@@ -73,13 +95,14 @@ class ReplayMaster : public Card {
         if (output_path.has_value()) {
             _output_path.emplace(output_path->copy());
         }
+        _input_source.verify_syncs();
     }
 
     virtual void become_front() {
         switch (_state) {
             case NEW:
                 _state = REPLAY;
-                init();
+                init_headless_game();
                 Randomize(4);  // For the decision to replay intro.
                 _game_result  = NO_GAME;
                 g.random.seed = _random_seed;
@@ -90,22 +113,7 @@ class ReplayMaster : public Card {
 
             case REPLAY:
                 if (_output_path.has_value()) {
-                    pn::string path = pn::format("{0}/debriefing.txt", *_output_path);
-                    sfz::makedirs(path::dirname(path), 0755);
-                    pn::output outcome{path, pn::text};
-                    if (g.victory_text.has_value()) {
-                        outcome.write(*g.victory_text);
-                        if (_game_result == WIN_GAME) {
-                            outcome.write("\n");
-                            Handle<Admiral> player(0);
-                            pn::string      text = DebriefingScreen::build_score_text(
-                                    g.time, g.level->solo.par.time, GetAdmiralLoss(player),
-                                    g.level->solo.par.losses, GetAdmiralKill(player),
-                                    g.level->solo.par.kills);
-                            outcome.write(text);
-                            outcome.write("\n");
-                        }
-                    }
+                    write_debriefing(*_output_path, _game_result);
                 }
                 stack()->pop(this);
                 break;
@@ -113,8 +121,6 @@ class ReplayMaster : public Card {
     }
 
   private:
-    void init();
-
     enum State {
         NEW,
         REPLAY,
@@ -128,20 +134,76 @@ class ReplayMaster : public Card {
     ReplayInputSource         _input_source;
 };
 
-void ReplayMaster::init() {
-    init_globals();
+// Plays a replay without drawing anything, then prints the outcome. Does the same setup as
+// ReplayMaster, but calls play_sim_only() instead of pushing MainPlay.
+//
+// If `upgrade_path` is given, also writes the replay there in the columnar format, with a sync
+// every `sync_interval` ticks if that is nonzero.
+//
+// If `ai` is given, computer players use it instead of the level's AI mode. The game then no
+// longer follows the recording, so its syncs are not checked.
+void replay_sim_only(
+        pn::data_view data, const sfz::optional<pn::string>& output_path,
+        const sfz::optional<pn::string>& upgrade_path, int sync_interval,
+        sfz::optional<LevelBase::AIMode> ai) {
+    ReplayData        replay_data(data);
+    ReplayInputSource input_source(&replay_data);
+    if (upgrade_path.has_value() && (sync_interval > 0)) {
+        input_source.record_syncs(sync_interval);
+    } else if (!ai.has_value()) {
+        input_source.verify_syncs();
+    }
 
-    sys.audio->set_global_volume(8);  // Max volume.
+    init_headless_game();
+    Randomize(4);  // For the decision to replay intro.
+    g.random.seed = replay_data.global_seed;
+    GameResult game_result =
+            play_sim_only(*Level::get(replay_data.chapter_id), &input_source, ai);
+
+    char sync[9];
+    snprintf(sync, sizeof(sync), "%08x", g.sync);
+    pn::string_view outcome = (game_result == WIN_GAME) ? "win" : "loss";
+    pn::out.format("sync: {0}\n", pn::string_view{sync});
+    pn::out.format("outcome: {0}\n", outcome);
+    pn::out.format("ticks: {0}\n", g.time.time_since_epoch().count());
+    if ((game_result == WIN_GAME) && (g.level->type() == Level::Type::SOLO)) {
+        Handle<Admiral> player(0);
+        pn::out.format(
+                "score: {0}\n",
+                DebriefingScreen::score(
+                        g.time, g.level->solo.par.time, GetAdmiralLoss(player),
+                        g.level->solo.par.losses, GetAdmiralKill(player),
+                        g.level->solo.par.kills));
+    }
 
-    sys_init();
-    Label::init();
-    Messages::init();
-    InstrumentInit();
-    SpriteHandlingInit();
-    PluginInit();
-    SpaceObjectHandlingInit();  // MUST be after PluginInit()
-    Admiral::init();
-    Vectors::init();
+    if (output_path.has_value()) {
+        write_debriefing(*output_path, game_result);
+    }
+    if (upgrade_path.has_value()) {
+        pn::output out{*upgrade_path, pn::binary};
+        replay_data.write_columnar_to(out);
+    }
+}
+
+// Seeks a sim-only replay to each tick in `seeks`, in the order given, and prints the sync value
+// at each. Seeking backwards restores a keyframe instead of starting over.
+void replay_seek(pn::data_view data, const std::vector<int>& seeks, int keyframe_interval) {
+    ReplayData        replay_data(data);
+    ReplayInputSource input_source(&replay_data);
+
+    init_headless_game();
+    Randomize(4);  // For the decision to replay intro.
+    g.random.seed = replay_data.global_seed;
+    SimSeeker seeker(*Level::get(replay_data.chapter_id), &input_source, ticks(keyframe_interval));
+
+    for (int t : seeks) {
+        seeker.seek(game_ticks(ticks(t)));
+        char sync[9];
+        snprintf(sync, sizeof(sync), "%08x", g.sync);
+        pn::out.format(
+                "tick {0}: sync {1}\n", g.time.time_since_epoch().count(),
+                pn::string_view{sync});
+    }
 }
 
 void usage(pn::output_view out, pn::string_view progname, int retcode) {
@@ -160,7 +222,29 @@ void usage(pn::output_view out, pn::string_view progname, int retcode) {
             "    -w, --width=WIDTH   screen width (default: 640)\n"
             "    -h, --height=HEIGHT screen height (default: 480)\n"
             "    -t, --text          produce text output\n"
+            "        --snapshot-on=EVENT\n"
+            "                        also take a screenshot when EVENT happens: destroy or\n"
+            "                        condition (repeatable)\n"
+            "        --frames=FILE   write screenshots to FILE (or - for stdout) as raw video\n"
+            "        --frame-format=FORMAT\n"
+            "                        y4m or rgba (default: y4m)\n"
             "    -s, --smoke         run as smoke text\n"
+            "        --sim-only      only simulate; print sync, outcome, and score\n"
+            "        --seek=TICK     with --sim-only, seek to TICK and print sync (repeatable)\n"
+            "        --keyframe-interval=TICKS\n"
+            "                        with --seek, keep a snapshot this often (default: 600)\n"
+            "        --upgrade=FILE  with --sim-only, also write the replay to FILE in the\n"
+            "                        columnar format\n"
+            "        --sync-interval=TICKS\n"
+            "                        with --upgrade, embed a sync every TICKS (default: none)\n"
+            "        --state-hashes=FILE\n"
+            "                        write per-tick simulation state hashes to FILE\n"
+            "        --state-dump-every=TICKS\n"
+            "                        with --state-hashes, also dump every field this often\n"
+            "        --state-dump-from=TICK\n"
+            "                        with --state-hashes, also dump every field from TICK on\n"
+            "        --ai=MODE       with --sim-only, run computer players with the legacy or\n"
+            "                        planner AI, instead of the level's choice\n"
             "        --help          display this help screen\n",
             progname);
     exit(retcode);
@@ -185,6 +269,12 @@ void main(int argc, char* const* argv) {
     int                       height   = 480;
     bool                      text     = false;
     bool                      smoke    = false;
+    bool                      sim_only = false;
+    sfz::optional<pn::string> state_hash_path;
+    int                       state_dump_every = 0;
+    int                       state_dump_from  = -1;
+    std::vector<int>          seeks;
+    int                       keyframe_interval = 600;
     callbacks.short_option             = [&output_dir, &interval, &width, &height, &text, &smoke](
                                      pn::rune opt, const args::callbacks::get_value_f& get_value) {
         switch (opt.value()) {
@@ -198,7 +288,16 @@ void main(int argc, char* const* argv) {
         }
     };
 
-    callbacks.long_option = [&argv, &callbacks](
+    std::vector<SnapshotTrigger>     snapshot_triggers;
+    sfz::optional<pn::string>        frames_path;
+    auto                             frame_format = OffscreenVideoDriver::FrameFormat::Y4M;
+    sfz::optional<pn::string>        upgrade_path;
+    int                              sync_interval = 0;
+    sfz::optional<LevelBase::AIMode> ai;
+
+    callbacks.long_option = [&argv, &callbacks, &sim_only, &state_hash_path, &state_dump_every,
+                             &state_dump_from, &seeks, &keyframe_interval, &snapshot_triggers,
+                             &frames_path, &frame_format, &upgrade_path, &sync_interval, &ai](
                                     pn::string_view                     opt,
                                     const args::callbacks::get_value_f& get_value) {
         if (opt == "output") {
@@ -213,6 +312,66 @@ void main(int argc, char* const* argv) {
             return callbacks.short_option(pn::rune{'t'}, get_value);
         } else if (opt == "smoke") {
             return callbacks.short_option(pn::rune{'s'}, get_value);
+        } else if (opt == "sim-only") {
+            sim_only = true;
+            return true;
+        } else if (opt == "seek") {
+            int t;
+            sfz::args::integer_option(get_value(), &t);
+            seeks.push_back(t);
+            return true;
+        } else if (opt == "keyframe-interval") {
+            sfz::args::integer_option(get_value(), &keyframe_interval);
+            return true;
+        } else if (opt == "upgrade") {
+            upgrade_path.emplace(get_value().copy());
+            return true;
+        } else if (opt == "sync-interval") {
+            sfz::args::integer_option(get_value(), &sync_interval);
+            return true;
+        } else if (opt == "state-hashes") {
+            state_hash_path.emplace(get_value().copy());
+            return true;
+        } else if (opt == "state-dump-every") {
+            sfz::args::integer_option(get_value(), &state_dump_every);
+            return true;
+        } else if (opt == "state-dump-from") {
+            sfz::args::integer_option(get_value(), &state_dump_from);
+            return true;
+        } else if (opt == "ai") {
+            pn::string_view mode = get_value();
+            if (mode == "legacy") {
+                ai = LevelBase::AIMode::LEGACY;
+            } else if (mode == "planner") {
+                ai = LevelBase::AIMode::PLANNER;
+            } else {
+                throw std::runtime_error(pn::format("invalid AI mode: {0}", mode).c_str());
+            }
+            return true;
+        } else if (opt == "snapshot-on") {
+            pn::string_view event = get_value();
+            if (event == "destroy") {
+                snapshot_triggers.push_back(SnapshotTrigger::OBJECT_DESTROYED);
+            } else if (event == "condition") {
+                snapshot_triggers.push_back(SnapshotTrigger::CONDITION_FIRED);
+            } else {
+                throw std::runtime_error(pn::format("invalid snapshot event: {0}", event).c_str());
+            }
+            return true;
+        } else if (opt == "frames") {
+            frames_path.emplace(get_value().copy());
+            return true;
+        } else if (opt == "frame-format") {
+            pn::string_view format = get_value();
+            if (format == "y4m") {
+                frame_format = OffscreenVideoDriver::FrameFormat::Y4M;
+            } else if (format == "rgba") {
+                frame_format = OffscreenVideoDriver::FrameFormat::RGBA;
+            } else {
+                throw std::runtime_error(
+                        pn::format("invalid frame format: {0}", format).c_str());
+            }
+            return true;
         } else if (opt == "help") {
             usage(pn::out, sfz::path::basename(argv[0]), 0);
             return true;
@@ -230,15 +389,36 @@ void main(int argc, char* const* argv) {
         sfz::makedirs(*output_dir, 0755);
     }
 
+    unique_ptr<StateHashLog> state_hash;
+    if (state_hash_path.has_value()) {
+        state_hash.reset(new StateHashLog(*state_hash_path, state_dump_every, state_dump_from));
+    }
+
+    if (sim_only) {
+        Preferences     preferences;
+        NullPrefsDriver prefs(preferences.copy());
+        NullSoundDriver sound;
+        NullLedger      ledger;
+        NullVideoDriver video({width, height});
+
+        sfz::mapped_file replay_file(*replay_path);
+        if (!seeks.empty()) {
+            replay_seek(replay_file.data(), seeks, keyframe_interval);
+        } else {
+            replay_sim_only(replay_file.data(), output_dir, upgrade_path, sync_interval, ai);
+        }
+        return;
+    }
+
     Preferences preferences;
     preferences.play_music_in_game = true;
     NullPrefsDriver prefs(preferences.copy());
 
     EventScheduler scheduler;
     scheduler.schedule_event(unique_ptr<Event>(new MouseMoveEvent(wall_time(), Point(320, 240))));
-    // TODO(sfiera): add recurring snapshots to OffscreenVideoDriver.
-    for (int64_t i = 1; i < 72000; i += interval) {
-        scheduler.schedule_snapshot(i);
+    scheduler.schedule_snapshots(1, interval);
+    for (SnapshotTrigger trigger : snapshot_triggers) {
+        scheduler.snapshot_on(trigger);
     }
 
     unique_ptr<SoundDriver> sound;
@@ -258,7 +438,16 @@ void main(int argc, char* const* argv) {
         TextVideoDriver video({width, height}, output_dir);
         video.loop(new ReplayMaster(replay_file.data(), output_dir), scheduler);
     } else {
-        OffscreenVideoDriver video({width, height}, output_dir);
+        sfz::optional<pn::output> frames_file;
+        OffscreenVideoDriver      video({width, height}, output_dir);
+        if (frames_path.has_value()) {
+            if (*frames_path == "-") {
+                video.set_frame_output(pn::out, frame_format, interval);
+            } else {
+                frames_file.emplace(*frames_path, pn::binary);
+                video.set_frame_output(*frames_file, frame_format, interval);
+            }
+        }
         video.loop(new ReplayMaster(replay_file.data(), output_dir), scheduler);
     }
 }
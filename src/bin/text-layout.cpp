@@ -0,0 +1,178 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <stdio.h>
+#include <chrono>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+#include <vector>
+
+#include "config/preferences.hpp"
+#include "data/level.hpp"
+#include "data/plugin.hpp"
+#include "drawing/color.hpp"
+#include "drawing/styled-text.hpp"
+#include "drawing/text.hpp"
+#include "game/sys.hpp"
+#include "lang/exception.hpp"
+#include "sound/driver.hpp"
+#include "video/null-driver.hpp"
+
+namespace args = sfz::args;
+
+namespace antares {
+namespace {
+
+struct Screen {
+    pn::string_view name;
+    int             width;
+    pn::string      text;
+};
+
+pn::string_view level_text(pn::string_view chapter, bool prologue) {
+    const Level& level = plug.levels.find(chapter.copy())->second;
+    return prologue ? *level.solo.prologue : *level.solo.epilogue;
+}
+
+// The text of a scrolling text screen, as BuildPix lays it out: without the "#+" lines, which
+// stand for pictures.
+pn::string without_pictures(pn::string_view text) {
+    pn::string result;
+    size_t     start = 0;
+    while (start < text.size()) {
+        size_t end = text.find("\n", start);
+        end        = (end == text.npos) ? text.size() : (end + 1);
+        auto line  = text.substr(start, end - start);
+        if ((line.size() < 2) || (line.substr(0, 2) != "#+")) {
+            result += line;
+        }
+        start = end;
+    }
+    return result;
+}
+
+pn::string microseconds(std::chrono::steady_clock::duration d, int iterations) {
+    char buffer[32];
+    snprintf(
+            buffer, sizeof(buffer), "%.1f",
+            std::chrono::duration<double, std::micro>(d).count() / iterations);
+    return buffer;
+}
+
+// Lays out `screen` `iterations` times, as BuildPix does, and measures it with string_width()
+// as many times. Prints the screen name, its length in bytes, its width on one line and its
+// height once laid out, and the average microseconds per layout and per measurement.
+void measure(const Screen& screen, int iterations) {
+    using std::chrono::steady_clock;
+    const RgbColor red = GetRGBTranslateColorShade(Hue::RED, LIGHTEST);
+
+    int  height = 0;
+    auto start  = steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        height = StyledText::retro(screen.text, {sys.fonts.title, screen.width - 11, 0, 2}, red)
+                         .height();
+    }
+    auto layout_time = steady_clock::now() - start;
+
+    int32_t width = 0;
+    start         = steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        width = sys.fonts.title.string_width(screen.text);
+    }
+    auto width_time = steady_clock::now() - start;
+
+    pn::out.format(
+            "{0}\t{1}\t{2}\t{3}\t{4}\t{5}\n", screen.name, screen.text.size(), width, height,
+            microseconds(layout_time, iterations), microseconds(width_time, iterations));
+}
+
+void usage(pn::output_view out, pn::string_view progname, int retcode) {
+    out.format(
+            "usage: {0} [OPTIONS]\n"
+            "\n"
+            "  Lays out the text of each scrolling text screen repeatedly, and prints the\n"
+            "  screen, its length in bytes, its width on one line, its height, and the\n"
+            "  average microseconds per layout and per string_width() of the whole text,\n"
+            "  one line per screen\n"
+            "\n"
+            "  options:\n"
+            "    -i, --iterations=N  layouts per screen (default: 100)\n"
+            "        --help          display this help screen\n",
+            progname);
+    exit(retcode);
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    callbacks.argument = [](pn::string_view arg) { return false; };
+
+    int iterations         = 100;
+    callbacks.short_option = [&iterations](
+                                     pn::rune opt, const args::callbacks::get_value_f& get_value) {
+        switch (opt.value()) {
+            case 'i': sfz::args::integer_option(get_value(), &iterations); return true;
+            default: return false;
+        }
+    };
+
+    callbacks.long_option = [&argv, &callbacks](
+                                    pn::string_view                     opt,
+                                    const args::callbacks::get_value_f& get_value) {
+        if (opt == "iterations") {
+            return callbacks.short_option(pn::rune{'i'}, get_value);
+        } else if (opt == "help") {
+            usage(pn::out, sfz::path::basename(argv[0]), 0);
+            return true;
+        } else {
+            return false;
+        }
+    };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if (iterations < 1) {
+        throw std::runtime_error(
+                pn::format("iterations must be positive (was {0})", iterations).c_str());
+    }
+
+    NullPrefsDriver prefs;
+    NullSoundDriver sound;
+    NullVideoDriver video({640, 480});
+    init_headless_game();
+
+    std::vector<Screen> screens;
+    screens.push_back(Screen{"gai-prologue", 450, without_pictures(level_text("ch01", true))});
+    screens.push_back(Screen{"tut-prologue", 450, without_pictures(level_text("tut1", true))});
+    screens.push_back(Screen{"can-prologue", 450, without_pictures(level_text("ch07", true))});
+    screens.push_back(Screen{"can-epilogue", 450, without_pictures(level_text("ch07", false))});
+    screens.push_back(Screen{"sal-prologue", 450, without_pictures(level_text("ch11", true))});
+    screens.push_back(Screen{"outro", 450, without_pictures(level_text("ch20", false))});
+    screens.push_back(Screen{"baz-prologue", 450, without_pictures(level_text("ch14", true))});
+    screens.push_back(Screen{"ele-prologue", 450, without_pictures(level_text("ch13", true))});
+    screens.push_back(Screen{"aud-prologue", 450, without_pictures(level_text("ch16", true))});
+    screens.push_back(Screen{"intro", 450, without_pictures(*plug.info.intro)});
+    screens.push_back(Screen{"about", 540, without_pictures(*plug.info.about)});
+
+    for (const Screen& screen : screens) {
+        measure(screen, iterations);
+    }
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
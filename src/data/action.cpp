@@ -178,6 +178,38 @@ Action::~Action() {
     }
 }
 
+ActionList::ActionList() = default;
+
+ActionList::ActionList(std::vector<Action> actions) : _actions{std::move(actions)} {
+    _ops.reserve(_actions.size());
+    for (const Action& a : _actions) {
+        Op op;
+        op.action = &a;
+        op.owner  = a.base.filter.owner.value_or(Owner::ANY);
+        op.flags  = 0;
+        if (a.base.override_.subject.has_value()) {
+            op.flags |= Op::OVERRIDE_SUBJECT;
+        }
+        if (a.base.override_.direct.has_value()) {
+            op.flags |= Op::OVERRIDE_DIRECT;
+        }
+        if (a.base.filter.attributes.bits || !a.base.filter.tags.tags.empty()) {
+            op.flags |= Op::FILTER;
+        }
+        if (a.base.reflexive.value_or(false)) {
+            op.flags |= Op::REFLEXIVE;
+        }
+        _ops.push_back(op);
+    }
+}
+
+ActionList::ActionList(ActionList&&)            = default;
+ActionList& ActionList::operator=(ActionList&&) = default;
+ActionList::~ActionList()                       = default;
+
+const Action* ActionList::begin() const { return _actions.data(); }
+const Action* ActionList::end() const { return _actions.data() + _actions.size(); }
+
 static uint32_t optional_flags(path_value x, const std::map<pn::string_view, int>& flags) {
     if (x.value().is_null()) {
         return 0;
@@ -576,6 +608,8 @@ static Action zoom_action(path_value x) {
     return required_struct<ZoomAction>(x, {COMMON_ACTION_FIELDS, {"value", &ZoomAction::value}});
 }
 
+DEFINE_FIELD_READER(ActionList) { return ActionList{read_field<std::vector<Action>>(x)}; }
+
 DEFINE_FIELD_READER(Action) {
     switch (required_object_type(x, read_field<Action::Type>)) {
         case Action::Type::AGE: return age_action(x);
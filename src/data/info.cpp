@@ -65,7 +65,8 @@ Info info(path_value x) {
                 {"author_url", &Info::author_url},
                 {"version", &Info::version},
                 {"intro", &Info::intro},
-                {"about", &Info::about}}));
+                {"about", &Info::about},
+                {"object_capacity", &Info::object_capacity}}));
 }
 
 }  // namespace antares
@@ -79,11 +79,19 @@ FIELD_READER(LevelBase::PlayerType) {
             x, {{"human", LevelBase::PlayerType::HUMAN}, {"cpu", LevelBase::PlayerType::CPU}});
 }
 
+FIELD_READER(LevelBase::AIMode) {
+    return optional_enum<LevelBase::AIMode>(
+                   x, {{"legacy", LevelBase::AIMode::LEGACY},
+                       {"planner", LevelBase::AIMode::PLANNER}})
+            .value_or(LevelBase::AIMode::LEGACY);
+}
+
 FIELD_READER(DemoLevel::Player) {
     return required_struct<DemoLevel::Player>(
             x, {{"name", &DemoLevel::Player::name},
                 {"race", &DemoLevel::Player::race},
-                {"earning_power", &DemoLevel::Player::earning_power}});
+                {"earning_power", &DemoLevel::Player::earning_power},
+                {"ai", &DemoLevel::Player::ai}});
 }
 
 FIELD_READER(SoloLevel::Player) {
@@ -92,7 +100,8 @@ FIELD_READER(SoloLevel::Player) {
                 {"name", &SoloLevel::Player::name},
                 {"race", &SoloLevel::Player::race},
                 {"hue", &SoloLevel::Player::hue},
-                {"earning_power", &SoloLevel::Player::earning_power}});
+                {"earning_power", &SoloLevel::Player::earning_power},
+                {"ai", &SoloLevel::Player::ai}});
 }
 
 FIELD_READER(NetLevel::Player) {
@@ -140,7 +149,8 @@ FIELD_READER(LevelBase::StatusLine) {
             {"song", &LevelBase::song},                                                          \
             {"status", &LevelBase::status},                                                      \
             {"start_time", &LevelBase::start_time},                                              \
-            {"angle", &LevelBase::angle}
+            {"angle", &LevelBase::angle},                                                        \
+            {"object_capacity", &LevelBase::object_capacity}
 // clang-format on
 
 FIELD_READER(LevelBase::Type) {
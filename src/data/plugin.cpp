@@ -30,6 +30,7 @@
 #include "data/level.hpp"
 #include "data/races.hpp"
 #include "data/resource.hpp"
+#include "drawing/styled-text.hpp"
 #include "game/sys.hpp"
 #include "lang/defines.hpp"
 
@@ -57,6 +58,8 @@ static void read_all_levels() {
 }
 
 void PluginInit() {
+    StyledText::clear_cached_interfaces();  // They may show pictures from the old plugin.
+
     plug.info = Resource::info();
     try {
         if (plug.info.format != kPluginFormat) {
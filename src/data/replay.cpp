@@ -19,8 +19,11 @@
 #include "data/replay.hpp"
 
 #include <fcntl.h>
+#include <string.h>
 #include <time.h>
 #include <unistd.h>
+#include <zlib.h>
+#include <algorithm>
 #include <pn/input>
 #include <pn/output>
 #include <sfz/sfz.hpp>
@@ -32,6 +35,7 @@
 
 using sfz::range;
 using std::map;
+using std::vector;
 
 namespace path = sfz::path;
 
@@ -39,10 +43,24 @@ namespace antares {
 
 ReplayData::ReplayData() {}
 
-ReplayData::ReplayData(pn::data_view in) {
+static bool is_columnar(pn::data_view in);
+static void read_columnar(pn::data_view in, uint64_t from, ReplayData* replay);
+
+ReplayData::ReplayData(pn::data_view in, uint64_t from) {
+    if (is_columnar(in)) {
+        read_columnar(in, from, this);
+        return;
+    }
     if (!read_from(in.input(), this)) {
         throw std::runtime_error("error while reading replay data");
     }
+    if (from > 0) {
+        actions.erase(
+                actions.begin(),
+                std::find_if(actions.begin(), actions.end(), [from](const Action& action) {
+                    return action.at >= from;
+                }));
+    }
 }
 
 void ReplayData::key_down(uint64_t at, uint32_t key) {
@@ -71,11 +89,12 @@ enum {
 };
 
 enum {
-    SCENARIO    = (0x01 << 3) | LENGTH_DELIMITED,
-    CHAPTER     = (0x02 << 3) | VARINT,
-    GLOBAL_SEED = (0x03 << 3) | VARINT,
-    DURATION    = (0x04 << 3) | VARINT,
-    ACTION      = (0x05 << 3) | LENGTH_DELIMITED,
+    SCENARIO      = (0x01 << 3) | LENGTH_DELIMITED,
+    CHAPTER       = (0x02 << 3) | VARINT,
+    GLOBAL_SEED   = (0x03 << 3) | VARINT,
+    DURATION      = (0x04 << 3) | VARINT,
+    ACTION        = (0x05 << 3) | LENGTH_DELIMITED,
+    SYNC_INTERVAL = (0x06 << 3) | VARINT,
 
     SCENARIO_IDENTIFIER = (0x01 << 3) | LENGTH_DELIMITED,
     SCENARIO_VERSION    = (0x02 << 3) | LENGTH_DELIMITED,
@@ -252,6 +271,11 @@ bool read_from(pn::input_view in, ReplayData* replay) {
                     return false;
                 }
                 break;
+            case SYNC_INTERVAL:
+                if (!read_varint(in, &replay->sync_interval)) {
+                    return false;
+                }
+                break;
         }
     }
 }
@@ -340,6 +364,308 @@ void ReplayData::Action::write_to(pn::output_view out) const {
     }
 }
 
+// The columnar format
+//
+// NLRP stores each action as its own message, which is simple to append to while recording, but
+// takes several bytes per key and has to be parsed field by field. The columnar format is meant
+// for archiving replays that are already finished:
+//
+//   magic    kColumnarMagic, which can't begin an NLRP file
+//   version  varint; kColumnarVersion
+//   header   varint length, then the scenario, chapter, seed, duration, and sync interval, tagged
+//            as in NLRP
+//   blocks   each with up to kActionsPerBlock actions, as described below
+//   syncs    varint count, then a compressed block of that many fixed32 values
+//   index    varint block count, then for each block, the tick of its first action and its offset
+//            in the file, both as varint deltas from the previous block's; then the offset of the
+//            syncs, as a varint delta from the last block's
+//   trailer  fixed32; the offset of the index in the file
+//
+// Each block is a varint uncompressed size, a varint compressed size, and the block compressed
+// with zlib. Uncompressed, it's a varint action count followed by three columns of varints: the
+// tick of each action, as a delta from the previous action in the block (the first is absolute);
+// a bitmask of the keys pressed in each action; and a bitmask of the keys released.
+//
+// Fixed-width values are little-endian.
+
+static const uint8_t  kColumnarMagic[] = {0xff, 'N', 'L', 'C'};
+static const uint64_t kColumnarVersion = 1;
+static const size_t   kActionsPerBlock = 4096;
+static const size_t   kColumnarTrailer = 4;
+static const int      kMaxColumnarKeys = 64;
+
+// One action, with its keys as bitmasks.
+struct ActionRow {
+    uint64_t at;
+    uint64_t keys_down;
+    uint64_t keys_up;
+};
+
+static bool is_columnar(pn::data_view in) {
+    return (in.size() >= sizeof(kColumnarMagic)) &&
+           (memcmp(in.data(), kColumnarMagic, sizeof(kColumnarMagic)) == 0);
+}
+
+static uint64_t key_bit(uint8_t key) {
+    if (key >= kMaxColumnarKeys) {
+        throw std::runtime_error(pn::format("key {0} doesn't fit in a key mask", key).c_str());
+    }
+    return uint64_t(1) << key;
+}
+
+// Keys in a bitmask are replayed in ascending order. So that an action's keys are replayed in
+// the order given, split it into several rows at the same tick where they aren't ascending.
+static void append_rows(const ReplayData::Action& action, vector<ActionRow>* rows) {
+    ActionRow row  = {action.at, 0, 0};
+    int       last = -1;
+    for (uint8_t key : action.keys_down) {
+        if (key <= last) {
+            rows->push_back(row);
+            row = {action.at, 0, 0};
+        }
+        row.keys_down |= key_bit(key);
+        last = key;
+    }
+    last = -1;
+    for (uint8_t key : action.keys_up) {
+        if (key <= last) {
+            rows->push_back(row);
+            row = {action.at, 0, 0};
+        }
+        row.keys_up |= key_bit(key);
+        last = key;
+    }
+    rows->push_back(row);
+}
+
+static void append_keys(uint64_t mask, std::vector<uint8_t>* keys) {
+    for (int key : range(kMaxColumnarKeys)) {
+        if (mask & (uint64_t(1) << key)) {
+            keys->push_back(key);
+        }
+    }
+}
+
+static void write_fixed32(pn::output_view out, uint32_t value) {
+    const uint8_t bytes[] = {
+            uint8_t(value), uint8_t(value >> 8), uint8_t(value >> 16), uint8_t(value >> 24)};
+    out.write(pn::data_view{bytes, 4});
+}
+
+static uint32_t read_fixed32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) |
+           (uint32_t(p[3]) << 24);
+}
+
+static void write_compressed(pn::output_view out, pn::data_view raw) {
+    uLongf               size = compressBound(raw.size());
+    std::vector<uint8_t> compressed(size);
+    if (compress2(compressed.data(), &size, raw.data(), raw.size(), Z_BEST_COMPRESSION) != Z_OK) {
+        throw std::runtime_error("error while compressing replay");
+    }
+    write_varint(out, raw.size());
+    write_varint(out, size);
+    out.write(pn::data_view{compressed.data(), static_cast<int>(size)});
+}
+
+static bool read_compressed(pn::input_view in, pn::data* raw) {
+    size_t raw_size, size;
+    if (!read_varint(in, &raw_size) || !read_varint(in, &size)) {
+        return false;
+    }
+    pn::data compressed;
+    compressed.resize(size);
+    if (!in.read(&compressed)) {
+        return false;
+    }
+    std::vector<uint8_t> bytes(raw_size);
+    uLongf               out_size = raw_size;
+    if ((uncompress(bytes.data(), &out_size, compressed.data(), size) != Z_OK) ||
+        (out_size != raw_size)) {
+        return false;
+    }
+    *raw = pn::data_view{bytes.data(), static_cast<int>(raw_size)}.copy();
+    return true;
+}
+
+static void write_block(pn::output_view out, const ActionRow* begin, const ActionRow* end) {
+    pn::data raw;
+    write_varint(raw.output(), end - begin);
+    uint64_t at = 0;
+    for (const ActionRow* row : range(begin, end)) {
+        write_varint(raw.output(), row->at - at);
+        at = row->at;
+    }
+    for (const ActionRow* row : range(begin, end)) {
+        write_varint(raw.output(), row->keys_down);
+    }
+    for (const ActionRow* row : range(begin, end)) {
+        write_varint(raw.output(), row->keys_up);
+    }
+    write_compressed(out, raw);
+}
+
+static bool read_block(pn::input_view in, uint64_t from, ReplayData* replay) {
+    pn::data raw;
+    if (!read_compressed(in, &raw)) {
+        return false;
+    }
+    pn::input         block = raw.input();
+    size_t            count;
+    vector<ActionRow> rows;
+    if (!read_varint(block, &count)) {
+        return false;
+    }
+    rows.resize(count);
+    uint64_t at = 0;
+    for (ActionRow& row : rows) {
+        uint64_t delta;
+        if (!read_varint(block, &delta)) {
+            return false;
+        }
+        at += delta;
+        row.at = at;
+    }
+    for (ActionRow& row : rows) {
+        if (!read_varint(block, &row.keys_down)) {
+            return false;
+        }
+    }
+    for (ActionRow& row : rows) {
+        if (!read_varint(block, &row.keys_up)) {
+            return false;
+        }
+    }
+
+    for (const ActionRow& row : rows) {
+        if (row.at < from) {
+            continue;
+        }
+        replay->actions.emplace_back();
+        ReplayData::Action& action = replay->actions.back();
+        action.at                  = row.at;
+        append_keys(row.keys_down, &action.keys_down);
+        append_keys(row.keys_up, &action.keys_up);
+    }
+    return true;
+}
+
+void ReplayData::write_columnar_to(pn::output_view out) const {
+    pn::data file;
+    file.output().write(pn::data_view{kColumnarMagic, 4});
+    write_varint(file.output(), kColumnarVersion);
+
+    pn::data header;
+    tag_message(header.output(), SCENARIO, scenario);
+    tag_varint(header.output(), CHAPTER, chapter_id);
+    tag_varint(header.output(), GLOBAL_SEED, global_seed);
+    tag_varint(header.output(), DURATION, duration);
+    tag_varint(header.output(), SYNC_INTERVAL, sync_interval);
+    write_varint(file.output(), header.size());
+    file.output().write(header);
+
+    vector<ActionRow> rows;
+    for (const Action& action : actions) {
+        append_rows(action, &rows);
+    }
+    vector<std::pair<uint64_t, uint64_t>> index;
+    for (size_t i = 0; i < rows.size(); i += kActionsPerBlock) {
+        const ActionRow* begin = rows.data() + i;
+        const ActionRow* end   = rows.data() + std::min(rows.size(), i + kActionsPerBlock);
+        index.emplace_back(begin->at, file.size());
+        write_block(file.output(), begin, end);
+    }
+
+    const uint64_t sync_offset = file.size();
+    pn::data       sync_bytes;
+    for (uint32_t sync : syncs) {
+        write_fixed32(sync_bytes.output(), sync);
+    }
+    write_varint(file.output(), syncs.size());
+    write_compressed(file.output(), sync_bytes);
+
+    const uint32_t index_offset = file.size();
+    write_varint(file.output(), index.size());
+    uint64_t at = 0, offset = 0;
+    for (const auto& entry : index) {
+        write_varint(file.output(), entry.first - at);
+        write_varint(file.output(), entry.second - offset);
+        at     = entry.first;
+        offset = entry.second;
+    }
+    write_varint(file.output(), sync_offset - offset);
+    write_fixed32(file.output(), index_offset);
+
+    out.write(file);
+}
+
+static void read_columnar(pn::data_view in, uint64_t from, ReplayData* replay) {
+    if (in.size() < (sizeof(kColumnarMagic) + kColumnarTrailer)) {
+        throw std::runtime_error("replay truncated");
+    }
+    pn::input file = in.slice(4, in.size() - 4).input();
+    uint64_t  version;
+    if (!read_varint(file, &version)) {
+        throw std::runtime_error("error while reading replay");
+    } else if (version != kColumnarVersion) {
+        throw std::runtime_error(pn::format("unsupported replay version {0}", version).c_str());
+    }
+    if (!read_message(file, replay)) {
+        throw std::runtime_error("error while reading replay header");
+    }
+
+    // Find the last block that starts before `from`, and read from there on. A block that starts
+    // at `from` might not be the first with actions at that tick.
+    const uint32_t index_offset = read_fixed32(in.data() + in.size() - kColumnarTrailer);
+    if (index_offset > (in.size() - kColumnarTrailer)) {
+        throw std::runtime_error("replay index truncated");
+    }
+    pn::input index = in.slice(index_offset, in.size() - index_offset).input();
+    size_t    block_count;
+    if (!read_varint(index, &block_count)) {
+        throw std::runtime_error("error while reading replay index");
+    }
+    uint64_t at = 0, offset = 0, start_offset = 0;
+    size_t   start_block = 0;
+    for (size_t i : range(block_count)) {
+        uint64_t at_delta, offset_delta;
+        if (!read_varint(index, &at_delta) || !read_varint(index, &offset_delta)) {
+            throw std::runtime_error("error while reading replay index");
+        }
+        at += at_delta;
+        offset += offset_delta;
+        if ((i == 0) || (at < from)) {
+            start_block  = i;
+            start_offset = offset;
+        }
+    }
+    uint64_t sync_offset_delta;
+    if (!read_varint(index, &sync_offset_delta) ||
+        ((offset + sync_offset_delta) > index_offset)) {
+        throw std::runtime_error("error while reading replay index");
+    }
+
+    pn::input blocks = in.slice(start_offset, in.size() - start_offset).input();
+    for (size_t i = start_block; i < block_count; ++i) {
+        if (!read_block(blocks, from, replay)) {
+            throw std::runtime_error("error while reading replay actions");
+        }
+    }
+
+    const uint64_t sync_offset = offset + sync_offset_delta;
+    pn::input      syncs       = in.slice(sync_offset, in.size() - sync_offset).input();
+    size_t         sync_count;
+    pn::data       sync_bytes;
+    if (!read_varint(syncs, &sync_count) || !read_compressed(syncs, &sync_bytes) ||
+        (sync_bytes.size() != (sync_count * 4))) {
+        throw std::runtime_error("error while reading replay syncs");
+    }
+    replay->syncs.resize(sync_count);
+    for (size_t i : range(sync_count)) {
+        replay->syncs[i] = read_fixed32(sync_bytes.data() + (i * 4));
+    }
+}
+
 ReplayBuilder::ReplayBuilder() {}
 
 static bool is_replay(pn::string_view s) { return s.rfind(".nlrp") == (s.size() - 5); }
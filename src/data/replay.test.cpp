@@ -0,0 +1,148 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "data/replay.hpp"
+
+#include <gmock/gmock.h>
+
+using testing::ElementsAre;
+using testing::Eq;
+using testing::SizeIs;
+
+namespace antares {
+namespace {
+
+using ReplayTest = testing::Test;
+
+ReplayData::Action action(
+        uint64_t at, std::vector<uint8_t> keys_down, std::vector<uint8_t> keys_up) {
+    ReplayData::Action a;
+    a.at        = at;
+    a.keys_down = keys_down;
+    a.keys_up   = keys_up;
+    return a;
+}
+
+ReplayData sample_replay() {
+    ReplayData replay;
+    replay.scenario.identifier = pn::string_view{"com.biggerplanet.ares"}.copy();
+    replay.scenario.version    = pn::string_view{"1.1.1"}.copy();
+    replay.chapter_id          = 12;
+    replay.global_seed         = -3;
+    replay.duration            = 20000;
+    for (uint64_t at = 1; at < 20000; at += 3) {
+        replay.actions.push_back(action(at, {uint8_t(at % 44)}, {}));
+        replay.actions.push_back(action(at + 1, {}, {uint8_t(at % 44)}));
+    }
+    return replay;
+}
+
+pn::data columnar(const ReplayData& replay) {
+    pn::data data;
+    replay.write_columnar_to(data.output());
+    return data;
+}
+
+pn::data nlrp(const ReplayData& replay) {
+    pn::data data;
+    replay.write_to(data.output());
+    return data;
+}
+
+void expect_same_actions(
+        const std::vector<ReplayData::Action>& actual,
+        const std::vector<ReplayData::Action>& expected) {
+    ASSERT_THAT(actual, SizeIs(expected.size()));
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_THAT(actual[i].at, Eq(expected[i].at));
+        EXPECT_THAT(actual[i].keys_down, Eq(expected[i].keys_down));
+        EXPECT_THAT(actual[i].keys_up, Eq(expected[i].keys_up));
+    }
+}
+
+TEST_F(ReplayTest, RoundTrip) {
+    ReplayData replay    = sample_replay();
+    replay.sync_interval = 60;
+    replay.syncs         = {0x01234567, 0x89abcdef, 0};
+
+    ReplayData read(columnar(replay));
+    EXPECT_THAT(read.scenario.identifier, Eq(replay.scenario.identifier));
+    EXPECT_THAT(read.scenario.version, Eq(replay.scenario.version));
+    EXPECT_THAT(read.chapter_id, Eq(12));
+    EXPECT_THAT(read.global_seed, Eq(-3));
+    EXPECT_THAT(read.duration, Eq(20000u));
+    EXPECT_THAT(read.sync_interval, Eq(60u));
+    EXPECT_THAT(read.syncs, ElementsAre(0x01234567, 0x89abcdef, 0));
+    expect_same_actions(read.actions, replay.actions);
+}
+
+TEST_F(ReplayTest, Empty) {
+    ReplayData replay;
+    replay.chapter_id  = 1;
+    replay.global_seed = 0;
+    replay.duration    = 0;
+
+    ReplayData read(columnar(replay));
+    EXPECT_THAT(read.actions, SizeIs(0));
+    EXPECT_THAT(read.syncs, SizeIs(0));
+}
+
+// Keys are stored as bitmasks, which lose their order, so actions with keys out of order are
+// split into several actions at the same tick. The keys must still come back in order.
+TEST_F(ReplayTest, KeyOrder) {
+    ReplayData replay;
+    replay.chapter_id  = 1;
+    replay.global_seed = 0;
+    replay.duration    = 10;
+    replay.actions.push_back(action(5, {9, 8, 8}, {3, 1}));
+
+    ReplayData           read(columnar(replay));
+    std::vector<uint8_t> keys_down, keys_up;
+    for (const auto& a : read.actions) {
+        EXPECT_THAT(a.at, Eq(5u));
+        EXPECT_TRUE(keys_up.empty() || a.keys_down.empty());
+        keys_down.insert(keys_down.end(), a.keys_down.begin(), a.keys_down.end());
+        keys_up.insert(keys_up.end(), a.keys_up.begin(), a.keys_up.end());
+    }
+    EXPECT_THAT(keys_down, ElementsAre(9, 8, 8));
+    EXPECT_THAT(keys_up, ElementsAre(3, 1));
+}
+
+TEST_F(ReplayTest, SmallerThanNlrp) {
+    ReplayData replay = sample_replay();
+    EXPECT_THAT(columnar(replay).size() * 4, testing::Lt(nlrp(replay).size()));
+}
+
+// Seeking skips whole blocks using the index, then drops any actions before the target within
+// the first block read. The result should match filtering the full list.
+TEST_F(ReplayTest, Seek) {
+    ReplayData replay = sample_replay();
+    pn::data   data   = columnar(replay);
+    for (uint64_t from : {0, 1, 2, 5000, 12289, 12290, 19999, 30000}) {
+        std::vector<ReplayData::Action> expected;
+        for (const auto& a : replay.actions) {
+            if (a.at >= from) {
+                expected.push_back(action(a.at, a.keys_down, a.keys_up));
+            }
+        }
+        expect_same_actions(ReplayData(data, from).actions, expected);
+        expect_same_actions(ReplayData(nlrp(replay), from).actions, expected);
+    }
+}
+
+}  // namespace
+}  // namespace antares
@@ -265,7 +265,7 @@ std::vector<sfz::optional<BriefingSprite>> render_briefing(
         }
     }
 
-    result.resize(kMaxSpaceObject);
+    result.resize(g.object_slots.capacity());
 
     for (auto anObject : SpaceObject::all()) {
         if (!((anObject->active == kObjectInUse) && anObject->sprite.get())) {
@@ -41,7 +41,7 @@ const Font& interface_font(InterfaceStyle style) {
 }
 
 void draw_text_in_rect(Rect tRect, pn::string_view text, InterfaceStyle style, Hue hue) {
-    const StyledText interface_text = StyledText::interface(
+    const StyledText& interface_text = StyledText::cached_interface(
             text,
             {interface_font(style), tRect.width(), kInterfaceTextHBuffer, kInterfaceTextVBuffer},
             GetRGBTranslateColorShade(hue, LIGHTEST));
@@ -51,7 +51,7 @@ void draw_text_in_rect(Rect tRect, pn::string_view text, InterfaceStyle style, H
 
 int16_t GetInterfaceTextHeightFromWidth(
         pn::string_view text, InterfaceStyle style, int16_t boundsWidth) {
-    const StyledText interface_text = StyledText::interface(
+    const StyledText& interface_text = StyledText::cached_interface(
             text,
             {interface_font(style), boundsWidth, kInterfaceTextHBuffer, kInterfaceTextVBuffer});
     return interface_text.height();
@@ -79,6 +79,27 @@ void PixMap::composite(const PixMap& pix) {
     }
 }
 
+void PixMap::tint_overlay(const PixMap& overlay, Hue hue) {
+    if (size() != overlay.size()) {
+        throw std::runtime_error("Mismatch in PixMap sizes");
+    }
+    for (int y = 0; y < size().height; ++y) {
+        for (int x = 0; x < size().width; ++x) {
+            RgbColor over  = overlay.get(x, y);
+            uint8_t  value = over.red;
+            uint8_t  frac  = over.alpha;
+            over           = RgbColor::tint(hue, value);
+            RgbColor under = get(x, y);
+            RgbColor composite;
+            composite.red   = ((over.red * frac) + (under.red * (255 - frac))) / 255;
+            composite.green = ((over.green * frac) + (under.green * (255 - frac))) / 255;
+            composite.blue  = ((over.blue * frac) + (under.blue * (255 - frac))) / 255;
+            composite.alpha = under.alpha;
+            set(x, y, composite);
+        }
+    }
+}
+
 ArrayPixMap::ArrayPixMap(int32_t width, int32_t height)
         : _size(width, height), _bytes(new RgbColor[width * height]) {}
 
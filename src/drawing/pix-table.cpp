@@ -18,6 +18,7 @@
 
 #include "drawing/pix-table.hpp"
 
+#include <algorithm>
 #include <pn/array>
 #include <pn/map>
 #include <pn/output>
@@ -31,12 +32,75 @@
 
 using sfz::range;
 using sfz::StringMap;
+using std::max;
 using std::unique_ptr;
 using std::vector;
 
 namespace antares {
 
-NatePixTable::NatePixTable(pn::string_view name, Hue hue) {
+SpriteAtlas::SpriteAtlas() {}
+SpriteAtlas::~SpriteAtlas() {}
+
+const SpriteAtlas::Page* SpriteAtlas::add(
+        const PixMap& image, const PixMap& overlay, Rect* rect) {
+    if (_pages.empty() || !_pages.back()->place(image.size(), rect)) {
+        // Frames too big for a normal page get a page to themselves. There's a pixel of clear
+        // space right and below each frame, so they don't bleed into each other.
+        Size size = {
+                max(kAtlasPageSize, image.size().width + 1),
+                max(kAtlasPageSize, image.size().height + 1),
+        };
+        _pages.emplace_back(new Page(size, _pages.size()));
+        if (!_pages.back()->place(image.size(), rect)) {
+            throw std::runtime_error("sprite frame doesn't fit in empty atlas page");
+        }
+    }
+    _pages.back()->copy(*rect, image, overlay);
+    return _pages.back().get();
+}
+
+void SpriteAtlas::clear() { _pages.clear(); }
+
+SpriteAtlas::Page::Page(Size size, int index) : _index(index), _pix_map(size), _overlay(size) {
+    _pix_map.fill(RgbColor::clear());
+    _overlay.fill(RgbColor::clear());
+}
+
+SpriteAtlas::Page::~Page() {}
+
+bool SpriteAtlas::Page::place(Size size, Rect* rect) {
+    const Size page = _pix_map.size();
+    if ((_shelf_right + size.width + 1) > page.width) {
+        _shelf_top += _shelf_height;
+        _shelf_height = 0;
+        _shelf_right  = 0;
+    }
+    if (((_shelf_right + size.width + 1) > page.width) ||
+        ((_shelf_top + size.height + 1) > page.height)) {
+        return false;
+    }
+    *rect = Rect{Point{_shelf_right, _shelf_top}, size};
+    _shelf_right += size.width + 1;
+    _shelf_height = max(_shelf_height, size.height + 1);
+    return true;
+}
+
+void SpriteAtlas::Page::copy(const Rect& rect, const PixMap& image, const PixMap& overlay) {
+    _pix_map.view(rect).copy(image);
+    _overlay.view(rect).copy(overlay);
+    _dirty = true;
+}
+
+const Texture& SpriteAtlas::Page::texture() const {
+    if (_dirty) {
+        _texture = sys.video->hued_texture(
+                pn::format("/sprites/atlas%{0}", _index), _pix_map, _overlay, 1);
+        _dirty = false;
+    }
+    return _texture;
+}
+
+NatePixTable::NatePixTable(pn::string_view name, Hue hue, SpriteAtlas* atlas) {
     SpriteData  data    = Resource::sprite_data(name);
     ArrayPixMap image   = Resource::sprite_image(name);
     ArrayPixMap overlay = Resource::sprite_overlay(name);
@@ -49,11 +113,14 @@ NatePixTable::NatePixTable(pn::string_view name, Hue hue) {
         Rect      sprite{frame.left, frame.top, frame.right, frame.bottom};
         Rect      bounds = sprite;
         bounds.offset(-frame.cx, -frame.cy);
-        if (hue == Hue::GRAY) {
-            _frames.emplace_back(bounds, image.view(sprite), name, i);
-        } else {
-            _frames.emplace_back(bounds, image.view(sprite), name, i, overlay.view(sprite), hue);
-        }
+        _frames.emplace_back(
+                bounds, image.view(sprite), overlay.view(sprite), hue, name, i, atlas);
+    }
+}
+
+NatePixTable::NatePixTable(const NatePixTable& base, Hue hue) {
+    for (const Frame& frame : base._frames) {
+        _frames.emplace_back(frame, hue);
     }
 }
 
@@ -64,50 +131,52 @@ const NatePixTable::Frame& NatePixTable::at(size_t index) const { return _frames
 size_t NatePixTable::size() const { return _size; }
 
 NatePixTable::Frame::Frame(
-        Rect bounds, const PixMap& image, pn::string_view name, int frame, const PixMap& overlay,
-        Hue hue)
-        : _bounds(bounds), _pix_map(bounds.width(), bounds.height()) {
-    load_image(image);
-    load_overlay(overlay, hue);
-    build(name, frame);
+        Rect bounds, const PixMap& image, const PixMap& overlay, Hue hue, pn::string_view name,
+        int frame, SpriteAtlas* atlas)
+        : _bounds(bounds),
+          _hue(hue),
+          _name(pn::format("/sprites/{0}%{1}", name, frame)),
+          _image(bounds.width(), bounds.height()),
+          _overlay(bounds.width(), bounds.height()) {
+    _image.copy(image);
+    _overlay.copy(overlay);
+    if (atlas) {
+        _page = atlas->add(_image, _overlay, &_page_rect);
+    }
 }
 
-NatePixTable::Frame::Frame(Rect bounds, const PixMap& image, pn::string_view name, int frame)
-        : _bounds(bounds), _pix_map(bounds.width(), bounds.height()) {
-    load_image(image);
-    build(name, frame);
-}
+NatePixTable::Frame::Frame(const Frame& base, Hue hue)
+        : _bounds(base._bounds),
+          _hue(hue),
+          _name(base._name.copy()),
+          _base(&base.base()),
+          _image(0, 0),
+          _overlay(0, 0),
+          _page(base._page),
+          _page_rect(base._page_rect) {}
 
 NatePixTable::Frame::~Frame() {}
 
-void NatePixTable::Frame::load_image(const PixMap& pix) { _pix_map.copy(pix); }
-
-void NatePixTable::Frame::load_overlay(const PixMap& pix, Hue hue) {
-    for (auto x : range(width())) {
-        for (auto y : range(height())) {
-            RgbColor over  = pix.get(x, y);
-            uint8_t  value = over.red;
-            uint8_t  frac  = over.alpha;
-            over           = RgbColor::tint(hue, value);
-            RgbColor under = _pix_map.get(x, y);
-            RgbColor composite;
-            composite.red   = ((over.red * frac) + (under.red * (255 - frac))) / 255;
-            composite.green = ((over.green * frac) + (under.green * (255 - frac))) / 255;
-            composite.blue  = ((over.blue * frac) + (under.blue * (255 - frac))) / 255;
-            composite.alpha = under.alpha;
-            _pix_map.set(x, y, composite);
-        }
+uint16_t NatePixTable::Frame::width() const { return _bounds.width(); }
+uint16_t NatePixTable::Frame::height() const { return _bounds.height(); }
+Point    NatePixTable::Frame::center() const { return {-_bounds.left, -_bounds.top}; }
+
+const PixMap& NatePixTable::Frame::pix_map() const {
+    if (_hue == Hue::GRAY) {
+        return base()._image;
+    } else if (!_tinted) {
+        _tinted.reset(new ArrayPixMap(size()));
+        _tinted->copy(base()._image);
+        _tinted->tint_overlay(base()._overlay, _hue);
     }
+    return *_tinted;
 }
 
-uint16_t       NatePixTable::Frame::width() const { return _bounds.width(); }
-uint16_t       NatePixTable::Frame::height() const { return _bounds.height(); }
-Point          NatePixTable::Frame::center() const { return {-_bounds.left, -_bounds.top}; }
-const PixMap&  NatePixTable::Frame::pix_map() const { return _pix_map; }
-const Texture& NatePixTable::Frame::texture() const { return _texture; }
-
-void NatePixTable::Frame::build(pn::string_view name, int frame) {
-    _texture = sys.video->texture(pn::format("/sprites/{0}%{1}", name, frame), _pix_map, 1);
+const Texture& NatePixTable::Frame::texture() const {
+    if (!_texture) {
+        _texture = sys.video->texture(_name, pix_map(), 1);
+    }
+    return _texture;
 }
 
 }  // namespace antares
@@ -18,6 +18,7 @@
 
 #include "drawing/sprite-handling.hpp"
 
+#include <algorithm>
 #include <numeric>
 #include <sfz/sfz.hpp>
 
@@ -27,6 +28,8 @@
 #include "drawing/shapes.hpp"
 #include "drawing/text.hpp"
 #include "game/globals.hpp"
+#include "game/sim-stats.hpp"
+#include "game/space-object.hpp"
 #include "game/sys.hpp"
 #include "lang/defines.hpp"
 #include "math/random.hpp"
@@ -70,9 +73,10 @@ static draw_tiny_t draw_tiny_function(BaseObject::Icon::Shape shape, int size) {
 
 Scale ANTARES_GLOBAL gAbsoluteScale = MIN_SCALE;
 
+size_t ANTARES_GLOBAL Sprite::size = 0;
+
 void SpriteHandlingInit() {
-    g.sprites.reset(new Sprite[Sprite::size]);
-    ResetAllSprites();
+    ResetAllSprites(kMaxSpaceObject);
 
     for (int i = 0; i < 4000; ++i) {
         Randomize(256);
@@ -86,6 +90,8 @@ Sprite* Sprite::get(int number) {
     return nullptr;
 }
 
+UsedHandleList<Sprite> Sprite::live() { return UsedHandleList<Sprite>(g.sprite_slots); }
+
 Sprite::Sprite()
         : table(NULL),
           style(spriteNormal),
@@ -93,16 +99,59 @@ Sprite::Sprite()
           styleData(0),
           whichLayer(BaseObject::Layer::NONE),
           killMe(false),
-          draw_tiny(NULL) {}
+          draw_tiny(NULL),
+          drawIndex(-1) {}
+
+// The sprites in use on each layer, in no particular order. They're added, removed, and moved
+// between lists as sprites are, so that drawing a layer visits only the sprites on it.
+static ANTARES_GLOBAL std::vector<Handle<Sprite>> layer_sprites[4];
+
+// Slots of the sprites of the layer being drawn, in order.
+static ANTARES_GLOBAL std::vector<int> draw_order;
+
+static std::vector<Handle<Sprite>>& layer_list(BaseObject::Layer layer) {
+    return layer_sprites[static_cast<int>(layer)];
+}
+
+static void link_sprite(Handle<Sprite> sprite) {
+    auto& list        = layer_list(sprite->whichLayer);
+    sprite->drawIndex = list.size();
+    list.push_back(sprite);
+}
 
-void ResetAllSprites() {
+static void unlink_sprite(Handle<Sprite> sprite) {
+    if (sprite->drawIndex < 0) {
+        return;
+    }
+    auto& list = layer_list(sprite->whichLayer);
+    auto  last = list.back();
+    list.pop_back();
+    if (last != sprite) {
+        list[sprite->drawIndex] = last;
+        last->drawIndex         = sprite->drawIndex;
+    }
+    sprite->drawIndex = -1;
+}
+
+void ResetAllSprites(int32_t object_capacity) {
+    // Two per object, as in the original 500 sprites for 250 objects.
+    size_t size = 2 * object_capacity;
+    if (!g.sprites || (size != Sprite::size)) {
+        g.sprites.reset(new Sprite[size]);
+        Sprite::size = size;
+    }
     for (auto sprite : Sprite::all()) {
         *sprite = Sprite();
     }
+    g.sprite_slots.reset(size);
+    for (auto& list : layer_sprites) {
+        list.clear();
+    }
 }
 
 void Pix::reset() {
     _pix.clear();
+    _atlas.clear();
     _cursor.reset(new NatePixTable("gui/cursor", Hue::GRAY));
 }
 
@@ -112,8 +161,14 @@ NatePixTable* Pix::add(pn::string_view name, Hue hue) {
         return result;
     }
 
-    auto it = _pix.emplace(std::make_pair(name.copy(), hue), NatePixTable(name, hue)).first;
-    return &it->second;
+    if (hue != Hue::GRAY) {
+        // Tables in other hues share the frames of the gray one, and are tinted as they're drawn.
+        const NatePixTable* gray = add(name, Hue::GRAY);
+        auto it = _pix.emplace(std::make_pair(name.copy(), hue), NatePixTable(*gray, hue));
+        return &it.first->second;
+    }
+    auto it = _pix.emplace(std::make_pair(name.copy(), hue), NatePixTable(name, hue, &_atlas));
+    return &it.first->second;
 }
 
 NatePixTable* Pix::get(pn::string_view id, Hue hue) {
@@ -130,31 +185,54 @@ Handle<Sprite> AddSprite(
         Point where, NatePixTable* table, pn::string_view name, Hue hue, int16_t whichShape,
         Scale scale, sfz::optional<BaseObject::Icon> icon, BaseObject::Layer layer, Hue tiny_hue,
         uint8_t tiny_shade) {
-    for (Handle<Sprite> sprite : Sprite::all()) {
-        if (sprite->table == NULL) {
-            sprite->where      = where;
-            sprite->table      = table;
-            sprite->whichShape = whichShape;
-            sprite->scale      = scale;
-            sprite->whichLayer = layer;
-            sprite->icon = icon.value_or(BaseObject::Icon{BaseObject::Icon::Shape::SQUARE, 0});
-            sprite->tinyColor  = {tiny_hue, tiny_shade};
-            sprite->draw_tiny  = draw_tiny_function(sprite->icon.shape, sprite->icon.size);
-            sprite->killMe     = false;
-            sprite->style      = spriteNormal;
-            sprite->styleColor = RgbColor::white();
-            sprite->styleData  = 0;
-
-            return sprite;
+    Handle<Sprite> sprite(g.sprite_slots.allocate());
+    if (!sprite.get()) {
+        if (sys.sim_stats) {
+            ++sys.sim_stats->sprites.dropped;
         }
+        return Sprite::none();
     }
 
-    return Sprite::none();
+    sprite->where      = where;
+    sprite->table      = table;
+    sprite->whichShape = whichShape;
+    sprite->scale      = scale;
+    sprite->whichLayer = layer;
+    sprite->icon       = icon.value_or(BaseObject::Icon{BaseObject::Icon::Shape::SQUARE, 0});
+    sprite->tinyColor  = {tiny_hue, tiny_shade};
+    sprite->draw_tiny  = draw_tiny_function(sprite->icon.shape, sprite->icon.size);
+    sprite->killMe     = false;
+    sprite->style      = spriteNormal;
+    sprite->styleColor = RgbColor::white();
+    sprite->styleData  = 0;
+    link_sprite(sprite);
+
+    return sprite;
 }
 
 void RemoveSprite(Handle<Sprite> sprite) {
+    unlink_sprite(sprite);
     sprite->killMe = false;
     sprite->table  = NULL;
+    g.sprite_slots.release(sprite.number());
+}
+
+void SetSpriteLayer(Handle<Sprite> sprite, BaseObject::Layer layer) {
+    unlink_sprite(sprite);
+    sprite->whichLayer = layer;
+    link_sprite(sprite);
+}
+
+void RebuildSpriteLayers() {
+    for (auto& list : layer_sprites) {
+        list.clear();
+    }
+    for (auto sprite : Sprite::all()) {
+        sprite->drawIndex = -1;
+    }
+    for (auto sprite : Sprite::live()) {
+        link_sprite(sprite);
+    }
 }
 
 Rect scale_sprite_rect(const NatePixTable::Frame& frame, Point where, Scale scale) {
@@ -165,37 +243,66 @@ Rect scale_sprite_rect(const NatePixTable::Frame& frame, Point where, Scale scal
     };
 }
 
+// Fills draw_order with the sprites of `layer` that should be drawn, in slot order, which is the
+// order they overlap in.
+static void sort_layer(BaseObject::Layer layer) {
+    draw_order.clear();
+    for (auto sprite : layer_list(layer)) {
+        if (!sprite->killMe) {
+            draw_order.push_back(sprite.number());
+        }
+    }
+    std::sort(draw_order.begin(), draw_order.end());
+}
+
 void draw_sprites() {
     if (gAbsoluteScale >= kBlipThreshhold) {
         for (BaseObject::Layer layer :
              {BaseObject::Layer::BASES, BaseObject::Layer::SHIPS, BaseObject::Layer::SHOTS}) {
-            for (auto aSprite : Sprite::all()) {
-                if ((aSprite->table != NULL) && !aSprite->killMe &&
-                    (aSprite->whichLayer == layer)) {
-                    Scale trueScale                  = scale_by(aSprite->scale, gAbsoluteScale);
-                    const NatePixTable::Frame& frame = aSprite->table->at(aSprite->whichShape);
-
-                    Rect draw_rect = scale_sprite_rect(frame, aSprite->where, trueScale);
-
-                    switch (aSprite->style) {
-                        case spriteNormal: frame.texture().draw(draw_rect); break;
-
-                        case spriteColor:
-                            Randomize(63);
-                            frame.texture().draw_static(
-                                    draw_rect, aSprite->styleColor, aSprite->styleData);
+            // Runs of sprites from the same atlas page are drawn as one batch. Sprites still
+            // draw in order, so a new batch starts whenever the page changes.
+            sort_layer(layer);
+            const SpriteAtlas::Page* page = nullptr;
+            unique_ptr<Quads>        quads;
+            for (int slot : draw_order) {
+                Handle<Sprite>             aSprite(slot);
+                Scale                      trueScale = scale_by(aSprite->scale, gAbsoluteScale);
+                const NatePixTable::Frame& frame     = aSprite->table->at(aSprite->whichShape);
+
+                Rect draw_rect = scale_sprite_rect(frame, aSprite->where, trueScale);
+
+                switch (aSprite->style) {
+                    case spriteNormal:
+                        if (!frame.page()) {
+                            quads.reset();
+                            frame.texture().draw(draw_rect);
                             break;
-                    }
+                        }
+                        if (!quads || (frame.page() != page)) {
+                            quads.reset();
+                            page = frame.page();
+                            quads.reset(new Quads(page->texture()));
+                        }
+                        quads->draw(draw_rect, frame.page_rect(), frame.hue(), frame.name());
+                        break;
+
+                    case spriteColor:
+                        quads.reset();
+                        Randomize(63);
+                        frame.texture().draw_static(
+                                draw_rect, aSprite->styleColor, aSprite->styleData);
+                        break;
                 }
             }
         }
     } else {
         for (BaseObject::Layer layer :
              {BaseObject::Layer::BASES, BaseObject::Layer::SHIPS, BaseObject::Layer::SHOTS}) {
-            for (auto aSprite : Sprite::all()) {
-                int tinySize = aSprite->icon.size;
-                if ((aSprite->table != NULL) && !aSprite->killMe && tinySize &&
-                    (aSprite->draw_tiny != NULL) && (aSprite->whichLayer == layer)) {
+            sort_layer(layer);
+            for (int slot : draw_order) {
+                Handle<Sprite> aSprite(slot);
+                int            tinySize = aSprite->icon.size;
+                if (tinySize && (aSprite->draw_tiny != NULL)) {
                     Rect tiny_rect(-tinySize, -tinySize, tinySize, tinySize);
                     tiny_rect.offset(aSprite->where.h, aSprite->where.v);
                     aSprite->draw_tiny(
@@ -212,7 +319,7 @@ void draw_sprites() {
 // Asteroids before the player actually starts.
 
 void CullSprites() {
-    for (auto aSprite : Sprite::all()) {
+    for (auto aSprite : Sprite::live()) {
         if (aSprite->table != NULL) {
             if (aSprite->killMe) {
                 RemoveSprite(aSprite);
@@ -26,6 +26,7 @@
 #include "drawing/color.hpp"
 #include "drawing/text.hpp"
 #include "game/sys.hpp"
+#include "lang/defines.hpp"
 #include "video/driver.hpp"
 
 using std::unique_ptr;
@@ -44,6 +45,18 @@ static int hex_digit(pn::rune r) {
     throw std::runtime_error(pn::format("{0} is not a valid hex digit", c).c_str());
 }
 
+static const size_t kMaxCachedLayouts = 32;
+
+// Layouts kept by StyledText::cached_interface(), most recently used last.
+struct CachedLayout {
+    pn::string  text;
+    WrapMetrics metrics;
+    RgbColor    fore_color;
+    RgbColor    back_color;
+    StyledText  layout;
+};
+static ANTARES_GLOBAL std::vector<unique_ptr<CachedLayout>> cached_layouts;
+
 template <typename container>
 static auto last(container& c) -> decltype(c.end()) {
     auto it = c.end();
@@ -265,6 +278,31 @@ StyledText StyledText::interface(
     return t;
 }
 
+const StyledText& StyledText::cached_interface(
+        pn::string_view text, WrapMetrics metrics, RgbColor fore_color, RgbColor back_color) {
+    for (auto it = cached_layouts.begin(); it != cached_layouts.end(); ++it) {
+        const CachedLayout& c = **it;
+        if ((c.metrics.font == metrics.font) && (c.metrics.width == metrics.width) &&
+            (c.metrics.side_margin == metrics.side_margin) &&
+            (c.metrics.line_spacing == metrics.line_spacing) &&
+            (c.metrics.tab_width == metrics.tab_width) && (c.fore_color == fore_color) &&
+            (c.back_color == back_color) && (c.text == text)) {
+            std::rotate(it, it + 1, cached_layouts.end());
+            return cached_layouts.back()->layout;
+        }
+    }
+
+    if (cached_layouts.size() >= kMaxCachedLayouts) {
+        cached_layouts.erase(cached_layouts.begin());
+    }
+    cached_layouts.emplace_back(new CachedLayout{
+            text.copy(), metrics, fore_color, back_color,
+            interface(text, metrics, fore_color, back_color)});
+    return cached_layouts.back()->layout;
+}
+
+void StyledText::clear_cached_interfaces() { cached_layouts.clear(); }
+
 bool StyledText::done() const { return _chars ? _until == _chars->end() : true; }
 void StyledText::hide() { _until = _chars ? _chars->begin() : decltype(_until){}; }
 void StyledText::advance() {
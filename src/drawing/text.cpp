@@ -36,6 +36,8 @@ namespace antares {
 
 namespace {
 
+const uint32_t kDenseGlyphCount = 256;
+
 enum {
     kTacticalFontResID    = 5000,
     kComputerFontResID    = 5001,
@@ -54,8 +56,20 @@ Font::Font(
         : texture(std::move(texture)),
           logicalWidth(logical_width),
           height(height),
-          ascent(ascent),
-          _glyphs(glyphs) {}
+          ascent(ascent) {
+    auto it = glyphs.find(pn::rune{'?'});
+    if (it != glyphs.end()) {
+        _missing_glyph = it->second;
+    }
+    _dense_glyphs.assign(kDenseGlyphCount, _missing_glyph);
+    for (const auto& kv : glyphs) {
+        if (kv.first.value() < kDenseGlyphCount) {
+            _dense_glyphs[kv.first.value()] = kv.second;
+        } else {
+            _sparse_glyphs[kv.first.value()] = kv.second;
+        }
+    }
+}
 
 Font font(pn::string_view name) {
     FontData d       = Resource::font(name);
@@ -66,9 +80,12 @@ Font font(pn::string_view name) {
 Font::~Font() {}
 
 Rect Font::glyph_rect(pn::rune rune) const {
-    auto it = _glyphs.find(rune);
-    if (it == _glyphs.end()) {
-        return glyph_rect(pn::rune{'?'});
+    if (rune.value() < _dense_glyphs.size()) {
+        return _dense_glyphs[rune.value()];
+    }
+    auto it = _sparse_glyphs.find(rune.value());
+    if (it == _sparse_glyphs.end()) {
+        return _missing_glyph;
     }
     return it->second;
 }
@@ -18,6 +18,7 @@
 
 #include "game/action.hpp"
 
+#include <algorithm>
 #include <set>
 #include <sfz/sfz.hpp>
 
@@ -37,6 +38,7 @@
 #include "game/motion.hpp"
 #include "game/non-player-ship.hpp"
 #include "game/player-ship.hpp"
+#include "game/snapshot.hpp"
 #include "game/space-object.hpp"
 #include "game/starfield.hpp"
 #include "game/sys.hpp"
@@ -55,11 +57,11 @@ using std::unique_ptr;
 
 namespace antares {
 
-const size_t kActionQueueLength = 120;
+const size_t kActionQueueInitialCapacity = 120;
 
 struct ActionCursor {
-    const Action* begin = nullptr;
-    const Action* end   = nullptr;
+    const ActionList::Op* begin = nullptr;
+    const ActionList::Op* end   = nullptr;
 
     Handle<SpaceObject> subject;
     int32_t             subject_id;
@@ -72,20 +74,20 @@ struct ActionCursor {
 
     ActionCursor() = default;
     ActionCursor(
-            const std::vector<Action>& actions, Handle<SpaceObject> subject,
-            Handle<SpaceObject> direct, Point offset)
-            : begin{actions.data()},
-              end{actions.data() + actions.size()},
+            const ActionList& actions, Handle<SpaceObject> subject, Handle<SpaceObject> direct,
+            Point offset)
+            : begin{actions.ops_begin()},
+              end{actions.ops_end()},
               subject{subject},
               subject_id{subject.get() ? subject->id : -1},
               direct{direct},
               direct_id{direct.get() ? direct->id : -1},
               offset{offset} {}
     ActionCursor(
-            const std::vector<Action>& actions, Handle<SpaceObject> subject,
-            Handle<SpaceObject> direct, Point offset, ActionCursor continuation)
-            : begin{actions.data()},
-              end{actions.data() + actions.size()},
+            const ActionList& actions, Handle<SpaceObject> subject, Handle<SpaceObject> direct,
+            Point offset, ActionCursor continuation)
+            : begin{actions.ops_begin()},
+              end{actions.ops_end()},
               subject{subject},
               subject_id{subject.get() ? subject->id : -1},
               direct{direct},
@@ -95,13 +97,20 @@ struct ActionCursor {
 };
 
 struct actionQueueType {
-    ActionCursor     cursor;
-    ticks            scheduledTime;
-    actionQueueType* nextActionQueue;
-
-    bool empty() const { return cursor.begin == cursor.end; }
+    ActionCursor cursor;
+    ticks        due;  // Runs once g.action_queue.now reaches this.
+    int64_t      seq;  // Position in the order that actions were queued in.
 };
 
+// True if `x` should run after `y`. Actions that are due at the same time run newest first, as
+// they did when the queue was a linked list sorted by insertion; replays depend on the order.
+static bool runs_after(const actionQueueType& x, const actionQueueType& y) {
+    if (x.due != y.due) {
+        return x.due > y.due;
+    }
+    return x.seq < y.seq;
+}
+
 ActionQueue::ActionQueue()  = default;
 ActionQueue::~ActionQueue() = default;
 
@@ -514,6 +523,7 @@ static void apply(
 
     direct->location.h = newLocation.h;
     direct->location.v = newLocation.v;
+    InvalidateManualSelectIndex();
 }
 
 static void alter_weapon(
@@ -783,14 +793,15 @@ static ActionCursor apply(
 static void execute_actions(ActionCursor cursor) {
     while (true) {
         while (cursor.begin != cursor.end) {
-            const Action& action = *(cursor.begin++);
+            const ActionList::Op& op     = *(cursor.begin++);
+            const Action&         action = *op.action;
 
             auto subject = cursor.subject;
             auto direct  = cursor.direct;
-            if (action.base.override_.subject.has_value()) {
+            if (op.flags & ActionList::Op::OVERRIDE_SUBJECT) {
                 subject = resolve_object_ref(*action.base.override_.subject);
             }
-            if (action.base.override_.direct.has_value()) {
+            if (op.flags & ActionList::Op::OVERRIDE_DIRECT) {
                 direct = resolve_object_ref(*action.base.override_.direct);
             }
 
@@ -798,20 +809,19 @@ static void execute_actions(ActionCursor cursor) {
                 direct = subject;
             }
 
-            auto owner_filter = action.base.filter.owner.value_or(Owner::ANY);
-            if (direct.get() && subject.get()) {
-                if (((owner_filter == Owner::DIFFERENT) && (direct->owner == subject->owner)) ||
-                    ((owner_filter == Owner::SAME) && (direct->owner != subject->owner))) {
+            if ((op.owner != Owner::ANY) && direct.get() && subject.get()) {
+                if (((op.owner == Owner::DIFFERENT) && (direct->owner == subject->owner)) ||
+                    ((op.owner == Owner::SAME) && (direct->owner != subject->owner))) {
                     continue;
                 }
             }
 
-            if ((action.base.filter.attributes.bits || !action.base.filter.tags.tags.empty()) &&
+            if ((op.flags & ActionList::Op::FILTER) &&
                 (!direct.get() || !action_filter_applies_to(action, direct))) {
                 continue;
             }
 
-            if (action.base.reflexive.value_or(false)) {
+            if (op.flags & ActionList::Op::REFLEXIVE) {
                 std::swap(subject, direct);
             }
 
@@ -827,82 +837,87 @@ static void execute_actions(ActionCursor cursor) {
 }
 
 void exec(
-        const std::vector<Action>& actions, Handle<SpaceObject> subject,
-        Handle<SpaceObject> direct, Point offset) {
+        const ActionList& actions, Handle<SpaceObject> subject, Handle<SpaceObject> direct,
+        Point offset) {
     execute_actions(ActionCursor(actions, subject, direct, offset));
 }
 
 void reset_action_queue() {
-    g.action_queue.data.reset(new actionQueueType[kActionQueueLength]);
-
-    g.action_queue.first = NULL;
-
-    actionQueueType* action = g.action_queue.data.get();
-    for (int32_t i = 0; i < kActionQueueLength; i++) {
-        action->cursor.begin = action->cursor.end = nullptr;
-        ++action;
-    }
+    g.action_queue.now      = ticks(0);
+    g.action_queue.next_seq = 0;
+    g.action_queue.heap.clear();
+    g.action_queue.heap.reserve(kActionQueueInitialCapacity);
 }
 
 static void queue_action(ActionCursor cursor, ticks delayTime) {
-    int32_t          queueNumber = 0;
-    actionQueueType* actionQueue = g.action_queue.data.get();
-    while (!actionQueue->empty() && (queueNumber < kActionQueueLength)) {
-        actionQueue++;
-        queueNumber++;
-    }
-
-    if (queueNumber == kActionQueueLength) {
-        return;
-    }
-    actionQueue->cursor        = std::move(cursor);
-    actionQueue->scheduledTime = delayTime;
-
-    actionQueueType* previousQueue = NULL;
-    actionQueueType* nextQueue     = g.action_queue.first;
-    while (nextQueue && (nextQueue->scheduledTime < delayTime)) {
-        previousQueue = nextQueue;
-        nextQueue     = nextQueue->nextActionQueue;
-    }
-    if (previousQueue) {
-        actionQueue->nextActionQueue = previousQueue->nextActionQueue;
-
-        previousQueue->nextActionQueue = actionQueue;
-    } else {
-        actionQueue->nextActionQueue = g.action_queue.first;
-        g.action_queue.first         = actionQueue;
+    if ((cursor.begin == cursor.end) && !cursor.continuation) {
+        return;  // “delay” was the last action, so there is nothing left to run.
     }
+    auto& q = g.action_queue;
+    q.heap.push_back(actionQueueType{std::move(cursor), q.now + delayTime, q.next_seq++});
+    std::push_heap(q.heap.begin(), q.heap.end(), runs_after);
 }
 
 void execute_action_queue() {
-    for (int32_t i = 0; i < kActionQueueLength; i++) {
-        auto actionQueue = &g.action_queue.data[i];
-        if (!actionQueue->empty()) {
-            actionQueue->scheduledTime -= kMajorTick;
-        }
-    }
+    auto& q = g.action_queue;
+    q.now += kMajorTick;
+
+    while (!q.heap.empty() && (q.heap.front().due <= q.now)) {
+        std::pop_heap(q.heap.begin(), q.heap.end(), runs_after);
+        ActionCursor cursor = std::move(q.heap.back().cursor);
+        q.heap.pop_back();
 
-    while (g.action_queue.first && !g.action_queue.first->empty() &&
-           (g.action_queue.first->scheduledTime <= ticks(0))) {
         int32_t subjectid = -1;
-        if (g.action_queue.first->cursor.subject.get() &&
-            g.action_queue.first->cursor.subject->active) {
-            subjectid = g.action_queue.first->cursor.subject->id;
+        if (cursor.subject.get() && cursor.subject->active) {
+            subjectid = cursor.subject->id;
         }
 
         int32_t directid = -1;
-        if (g.action_queue.first->cursor.direct.get() &&
-            g.action_queue.first->cursor.direct->active) {
-            directid = g.action_queue.first->cursor.direct->id;
+        if (cursor.direct.get() && cursor.direct->active) {
+            directid = cursor.direct->id;
         }
-        if ((subjectid == g.action_queue.first->cursor.subject_id) &&
-            (directid == g.action_queue.first->cursor.direct_id)) {
-            execute_actions(std::move(g.action_queue.first->cursor));
+        if ((subjectid == cursor.subject_id) && (directid == cursor.direct_id)) {
+            execute_actions(std::move(cursor));
         }
+    }
+}
+
+int32_t action_queue_used() { return g.action_queue.heap.size(); }
+
+static void archive(StateArchive& a, ActionCursor& c) {
+    a(c.begin)(c.end)(c.subject)(c.subject_id)(c.direct)(c.direct_id)(c.offset);
+    bool has_continuation = (c.continuation != nullptr);
+    a(has_continuation);
+    if (a.is_loading()) {
+        c.continuation.reset(has_continuation ? new ActionCursor : nullptr);
+    }
+    if (has_continuation) {
+        a(*c.continuation);
+    }
+}
+
+static void archive(StateArchive& a, actionQueueType& q) { a(q.cursor)(q.due)(q.seq); }
+
+void archive_action_queue(StateArchive& a) {
+    a(g.action_queue.now)(g.action_queue.next_seq)(g.action_queue.heap);
+}
+
+std::vector<QueuedAction> queued_actions() {
+    std::vector<const actionQueueType*> order;
+    for (const auto& q : g.action_queue.heap) {
+        order.push_back(&q);
+    }
+    std::sort(order.begin(), order.end(), [](const actionQueueType* x, const actionQueueType* y) {
+        return runs_after(*y, *x);
+    });
 
-        g.action_queue.first->cursor.begin = g.action_queue.first->cursor.end = nullptr;
-        g.action_queue.first = g.action_queue.first->nextActionQueue;
+    std::vector<QueuedAction> result;
+    for (auto q : order) {
+        result.push_back(QueuedAction{
+                q->due - g.action_queue.now, q->cursor.subject_id, q->cursor.direct_id,
+                q->cursor.offset, static_cast<int32_t>(q->cursor.end - q->cursor.begin)});
     }
+    return result;
 }
 
 }  // namespace antares
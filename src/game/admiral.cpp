@@ -23,9 +23,11 @@
 #include "data/resource.hpp"
 #include "game/cheat.hpp"
 #include "game/globals.hpp"
+#include "game/snapshot.hpp"
 #include "game/space-object.hpp"
 #include "game/sys.hpp"
 #include "lang/casts.hpp"
+#include "lang/defines.hpp"
 #include "math/macros.hpp"
 #include "math/random.hpp"
 #include "math/units.hpp"
@@ -47,6 +49,8 @@ static const Fixed kImportantTarget         = Fixed::from_float(1.250);
 static const Fixed kSomewhatImportantTarget = Fixed::from_float(1.125);
 static const Fixed kAbsolutelyEssential     = Fixed::from_float(128.0);
 
+static const int32_t kPlannerPeriod = 20;  // major ticks between passes of the planner
+
 static bool could_target_per_destination_flag(const BaseObject& base, const SpaceObject& target) {
     return base.ai.target.force.base.has_value()
                    ? (!!(target.attributes & kIsDestination) == *base.ai.target.force.base)
@@ -81,6 +85,29 @@ void Admiral::reset() {
     }
 }
 
+static void archive(StateArchive& a, BuildableObject& b) { a(b.name); }
+
+static void archive(StateArchive& a, admiralBuildType& b) {
+    a(b.base)(b.buildable)(b.chanceRange);
+}
+
+void archive_admirals(StateArchive& a) {
+    for (auto adm : Admiral::all()) {
+        a(adm->_attributes)(adm->_has_destination)(adm->_destinationObject);
+        a(adm->_destinationObjectID)(adm->_flagship)(adm->_considerShip)(adm->_considerShipID);
+        a(adm->_considerDestination)(adm->_buildAtObject)(adm->_cash);
+        a(adm->_saveGoal)(adm->_earning_power)(adm->_kills)(adm->_losses)(adm->_shipsLeft);
+        a(adm->_score)(adm->_blitzkrieg)(adm->_lastFreeEscortStrength);
+        a(adm->_thisFreeEscortStrength)(adm->_canBuildType)(adm->_totalBuildChance);
+        a(adm->_hopeToBuild)(adm->_hue)(adm->_active)(adm->_cheats)(adm->_name);
+        a(adm->_planDelay);
+    }
+    for (auto d : Destination::all()) {
+        a(d->whichObject)(d->canBuildType)(d->occupied)(d->earn)(d->buildTime);
+        a(d->totalBuildTime)(d->buildObjectBaseNum)(d->name);
+    }
+}
+
 void ResetAllDestObjectData() {
     for (auto d : Destination::all()) {
         d->whichObject = SpaceObject::none();
@@ -111,13 +138,24 @@ Admiral* Admiral::get(int i) {
     return nullptr;
 }
 
+static uint32_t computer_attributes(LevelBase::AIMode ai) {
+    switch (ai) {
+        case LevelBase::AIMode::LEGACY: return kAIsComputer;
+        case LevelBase::AIMode::PLANNER: return kAIsComputer | kAIsPlanner;
+    }
+}
+
 Handle<Admiral> Admiral::make(int index, const DemoLevel::Player& player) {
-    return make(index, kAIsComputer, player.name, player.earning_power, player.race, player.hue);
+    return make(
+            index, computer_attributes(player.ai), player.name, player.earning_power,
+            player.race, player.hue);
 }
 
 Handle<Admiral> Admiral::make(int index, const SoloLevel::Player& player) {
     return make(
-            index, player.type == LevelBase::PlayerType::HUMAN ? kAIsHuman : kAIsComputer,
+            index,
+            player.type == LevelBase::PlayerType::HUMAN ? kAIsHuman
+                                                        : computer_attributes(player.ai),
             player.name, player.earning_power, player.race, player.hue);
 }
 
@@ -582,6 +620,205 @@ static void AdmiralBuildAtObject(
     }
 }
 
+// Friendly and hostile strength near `destObject`, from the point of view of `owner`. The
+// strength of a distance grid cell is kept on the last object in the cell along the far list.
+void local_strength(
+        Handle<SpaceObject> destObject, const Admiral* owner, Fixed* friendValue,
+        Fixed* foeValue) {
+    Point               gridLoc         = destObject->distanceGrid;
+    Handle<SpaceObject> otherDestObject = destObject;
+    Handle<SpaceObject> stepObject      = destObject;
+    while (stepObject->nextFarObject.get()) {
+        if ((stepObject->distanceGrid.h == gridLoc.h) &&
+            (stepObject->distanceGrid.v == gridLoc.v)) {
+            otherDestObject = stepObject;
+        }
+        stepObject = stepObject->nextFarObject;
+    }
+    if (otherDestObject->owner.get() == owner) {
+        *friendValue = otherDestObject->localFriendStrength;
+        *foeValue    = otherDestObject->localFoeStrength;
+    } else {
+        *foeValue    = otherDestObject->localFriendStrength;
+        *friendValue = otherDestObject->localFoeStrength;
+    }
+}
+
+// The value to `anObject` of heading for `destObject`, before any random perturbation.
+// `friendValue` and `foeValue` are the strengths near `destObject` from the point of view of
+// `anObject`'s owner, as found by `local_strength()`.
+Fixed target_value(
+        Handle<SpaceObject> anObject, Handle<SpaceObject> destObject, Fixed friendValue,
+        Fixed foeValue, int32_t blitzkrieg) {
+    int32_t difference;
+    Point   gridLoc;
+    Fixed   thisValue = kUnimportantTarget;
+
+    if (destObject->owner == anObject->owner) {
+        if (destObject->attributes & kIsDestination) {
+            if (destObject->escortStrength < destObject->base->ai.escort.need) {
+                thisValue = kAbsolutelyEssential;
+            } else if (foeValue != Fixed::zero()) {
+                if (foeValue >= friendValue) {
+                    thisValue = kMostImportantTarget;
+                } else if (foeValue > (friendValue >> 1)) {
+                    thisValue = kVeryImportantTarget;
+                } else {
+                    thisValue = kUnimportantTarget;
+                }
+            } else {
+                if ((blitzkrieg > 0) && (anObject->duty == eGuardDuty)) {
+                    thisValue = kUnimportantTarget;
+                } else {
+                    if (foeValue > Fixed::zero()) {
+                        thisValue = kSomewhatImportantTarget;
+                    } else {
+                        thisValue = kUnimportantTarget;
+                    }
+                }
+            }
+            if (anObject->base->orderFlags & kSoftTargetIsBase) {
+                thisValue <<= 3;
+            }
+            if (anObject->base->orderFlags & kHardTargetIsNotBase) {
+                thisValue = Fixed::zero();
+            }
+        } else {
+            if (destObject->base->ai.escort.class_ > anObject->base->ai.escort.class_) {
+                if (foeValue > friendValue) {
+                    thisValue = kMostImportantTarget;
+                } else {
+                    if (destObject->escortStrength < destObject->base->ai.escort.need) {
+                        thisValue = kMostImportantTarget;
+                    } else {
+                        thisValue = kUnimportantTarget;
+                    }
+                }
+            } else {
+                thisValue = kUnimportantTarget;
+            }
+            if (anObject->base->orderFlags & kSoftTargetIsNotBase) {
+                thisValue <<= 3;
+            }
+            if (anObject->base->orderFlags & kHardTargetIsBase) {
+                thisValue = Fixed::zero();
+            }
+        }
+        if (anObject->base->orderFlags & kSoftTargetIsFriend) {
+            thisValue <<= 3;
+        }
+        if (anObject->base->orderFlags & kHardTargetIsFoe) {
+            thisValue = Fixed::zero();
+        }
+    } else if (destObject->owner.get()) {
+        if ((anObject->duty == eGuardDuty) || (anObject->duty == eNoDuty)) {
+            if (destObject->attributes & kIsDestination) {
+                if (foeValue < friendValue) {
+                    thisValue = kMostImportantTarget;
+                } else {
+                    thisValue = kSomewhatImportantTarget;
+                }
+                if (blitzkrieg > 0) {
+                    thisValue <<= 2;
+                }
+                if (anObject->base->orderFlags & kSoftTargetIsBase) {
+                    thisValue <<= 3;
+                }
+
+                if (anObject->base->orderFlags & kHardTargetIsNotBase) {
+                    thisValue = Fixed::zero();
+                }
+            } else {
+                if (friendValue != Fixed::zero()) {
+                    if (friendValue < foeValue) {
+                        thisValue = kSomewhatImportantTarget;
+                    } else {
+                        thisValue = kUnimportantTarget;
+                    }
+                } else {
+                    thisValue = kLeastImportantTarget;
+                }
+                if (anObject->base->orderFlags & kSoftTargetIsNotBase) {
+                    thisValue <<= 1;
+                }
+
+                if (anObject->base->orderFlags & kHardTargetIsBase) {
+                    thisValue = Fixed::zero();
+                }
+            }
+        }
+        if (anObject->base->orderFlags & kSoftTargetIsFoe) {
+            thisValue <<= 3;
+        }
+        if (anObject->base->orderFlags & kHardTargetIsFriend) {
+            thisValue = Fixed::zero();
+        }
+    } else {
+        if (destObject->attributes & kIsDestination) {
+            thisValue = kVeryImportantTarget;
+            if (blitzkrieg > 0) {
+                thisValue <<= 2;
+            }
+            if (anObject->base->orderFlags & kSoftTargetIsBase) {
+                thisValue <<= 3;
+            }
+            if (anObject->base->orderFlags & kHardTargetIsNotBase) {
+                thisValue = Fixed::zero();
+            }
+        } else {
+            if (anObject->base->orderFlags & kSoftTargetIsNotBase) {
+                thisValue <<= 3;
+            }
+            if (anObject->base->orderFlags & kHardTargetIsBase) {
+                thisValue = Fixed::zero();
+            }
+        }
+        if (anObject->base->orderFlags & kSoftTargetIsFoe) {
+            thisValue <<= 3;
+        }
+        if (anObject->base->orderFlags & kHardTargetIsFriend) {
+            thisValue = Fixed::zero();
+        }
+    }
+
+    difference =
+            ABS(implicit_cast<int32_t>(destObject->location.h) -
+                implicit_cast<int32_t>(anObject->location.h));
+    gridLoc.h = difference;
+    difference =
+            ABS(implicit_cast<int32_t>(destObject->location.v) -
+                implicit_cast<int32_t>(anObject->location.v));
+    gridLoc.v = difference;
+
+    if ((gridLoc.h < kMaximumRelevantDistance) && (gridLoc.v < kMaximumRelevantDistance)) {
+        if (anObject->base->orderFlags & kSoftTargetIsLocal) {
+            thisValue <<= 3;
+        }
+        if (anObject->base->orderFlags & kHardTargetIsRemote) {
+            thisValue = Fixed::zero();
+        }
+    } else {
+        if (anObject->base->orderFlags & kSoftTargetIsRemote) {
+            thisValue <<= 3;
+        }
+        if (anObject->base->orderFlags & kHardTargetIsLocal) {
+            thisValue = Fixed::zero();
+        }
+    }
+
+    if (anObject->base->orderFlags & kSoftTargetMatchesTags) {
+        if (tags_match(*destObject->base, anObject->base->ai.target.prefer.tags)) {
+            thisValue <<= 3;
+        }
+    }
+    if (anObject->base->orderFlags & kHardTargetMatchesTags) {
+        if (!tags_match(*destObject->base, anObject->base->ai.target.force.tags)) {
+            thisValue = Fixed::zero();
+        }
+    }
+    return thisValue;
+}
+
 void AdmiralThink() {
     for (auto destBalance : Destination::all()) {
         destBalance->buildTime -= kMajorTick;
@@ -606,15 +843,97 @@ void AdmiralThink() {
     }
 }
 
+// Sends `anObject` to the best target it has considered, if that is better than where it is
+// already going, and counts it towards the admiral's free escort strength.
+void Admiral::decide(Handle<SpaceObject> anObject) {
+    if ((anObject->duty != eEscortDuty) && (anObject->duty != eHostileBaseDuty) &&
+        (anObject->bestConsideredTargetValue > anObject->currentTargetValue)) {
+        _destinationObject = anObject->bestConsideredTargetNumber;
+        _has_destination   = true;
+        if (_destinationObject.get()) {
+            auto destObject = _destinationObject;
+            if (destObject->active == kObjectInUse) {
+                _destinationObjectID         = destObject->id;
+                anObject->currentTargetValue = anObject->bestConsideredTargetValue;
+
+                Fixed thisValue = anObject->randomSeed.next(Fixed::from_float(0.5)) -
+                                  Fixed::from_float(0.25);
+                anObject->currentTargetValue += (thisValue * anObject->currentTargetValue);
+                SetObjectDestination(anObject);
+            }
+        }
+        _has_destination = false;
+    }
+
+    if ((anObject->duty != eEscortDuty) && (anObject->duty != eHostileBaseDuty)) {
+        _thisFreeEscortStrength += anObject->base->ai.escort.power;
+    }
+
+    anObject->bestConsideredTargetValue = kFixedNone;
+}
+
+// A destination considered by the planner, with its local strengths as seen by the admiral.
+struct PlannerTarget {
+    Handle<SpaceObject> object;
+    Fixed               friendValue;
+    Fixed               foeValue;
+};
+static ANTARES_GLOBAL std::vector<PlannerTarget> planner_targets;
+
+// Scores every (ship, destination) pair of the admiral in one pass, where the legacy AI scores a
+// single pair per call, so that every ship re-plans each pass instead of waiting its turn. The
+// local strength around each destination is found once per pass, not once per pair.
+void Admiral::plan() {
+    if (_planDelay > 0) {
+        --_planDelay;
+        return;
+    }
+    _planDelay = kPlannerPeriod - 1;
+
+    planner_targets.clear();
+    for (auto destObject : SpaceObject::all()) {
+        if ((destObject->active == kObjectInUse) && (destObject->attributes & kCanBeDestination)) {
+            PlannerTarget t;
+            t.object = destObject;
+            local_strength(destObject, this, &t.friendValue, &t.foeValue);
+            planner_targets.push_back(t);
+        }
+    }
+
+    for (auto anObject : SpaceObject::all()) {
+        if ((anObject->owner.get() != this) || !(anObject->attributes & kCanAcceptDestination) ||
+            (anObject->active != kObjectInUse)) {
+            continue;
+        }
+        for (const PlannerTarget& t : planner_targets) {
+            auto destObject = t.object;
+            if ((destObject == anObject) ||
+                ((anObject->owner == destObject->owner) &&
+                 (anObject->base->ai.escort.class_ >= destObject->base->ai.escort.class_))) {
+                continue;
+            }
+            Fixed thisValue =
+                    target_value(anObject, destObject, t.friendValue, t.foeValue, _blitzkrieg);
+            if (thisValue > Fixed::zero()) {
+                thisValue += anObject->randomSeed.next(thisValue >> 1) - (thisValue >> 2);
+            }
+            if (thisValue > anObject->bestConsideredTargetValue) {
+                anObject->bestConsideredTargetValue  = thisValue;
+                anObject->bestConsideredTargetNumber = destObject;
+            }
+        }
+        decide(anObject);
+    }
+
+    _lastFreeEscortStrength = _thisFreeEscortStrength;
+    _thisFreeEscortStrength = Fixed::zero();
+}
+
 void Admiral::think() {
     Handle<SpaceObject> anObject;
     Handle<SpaceObject> destObject;
-    Handle<SpaceObject> otherDestObject;
-    Handle<SpaceObject> stepObject;
     Handle<SpaceObject> origObject;
-    int32_t             difference;
     Fixed               friendValue, foeValue, thisValue;
-    Point               gridLoc;
 
     if (!(_attributes & kAIsComputer) || (_attributes & kAIsRemote)) {
         return;
@@ -644,6 +963,12 @@ void Admiral::think() {
         }
     }
 
+    if (_attributes & kAIsPlanner) {
+        plan();
+        think_build();
+        return;
+    }
+
     // get the current object
     if (!_considerShip.get()) {
         _considerShip = anObject = g.root;
@@ -675,30 +1000,7 @@ void Admiral::think() {
                 // ********************************
                 // SHIP MUST DECIDE, THEN INCREASE CONSIDER SHIP
                 // ********************************
-                if ((anObject->duty != eEscortDuty) && (anObject->duty != eHostileBaseDuty) &&
-                    (anObject->bestConsideredTargetValue > anObject->currentTargetValue)) {
-                    _destinationObject = anObject->bestConsideredTargetNumber;
-                    _has_destination   = true;
-                    if (_destinationObject.get()) {
-                        destObject = _destinationObject;
-                        if (destObject->active == kObjectInUse) {
-                            _destinationObjectID         = destObject->id;
-                            anObject->currentTargetValue = anObject->bestConsideredTargetValue;
-                            thisValue = anObject->randomSeed.next(Fixed::from_float(0.5)) -
-                                        Fixed::from_float(0.25);
-                            thisValue = (thisValue * anObject->currentTargetValue);
-                            anObject->currentTargetValue += thisValue;
-                            SetObjectDestination(anObject);
-                        }
-                    }
-                    _has_destination = false;
-                }
-
-                if ((anObject->duty != eEscortDuty) && (anObject->duty != eHostileBaseDuty)) {
-                    _thisFreeEscortStrength += anObject->base->ai.escort.power;
-                }
-
-                anObject->bestConsideredTargetValue = kFixedNone;
+                decide(anObject);
                 // start back with 1st ship
                 _destinationObject = g.root;
                 destObject         = g.root;
@@ -741,186 +1043,8 @@ void Admiral::think() {
             (destObject->active == kObjectInUse) &&
             ((anObject->owner != destObject->owner) ||
              (anObject->base->ai.escort.class_ < destObject->base->ai.escort.class_))) {
-            gridLoc    = destObject->distanceGrid;
-            stepObject = otherDestObject = destObject;
-            while (stepObject->nextFarObject.get()) {
-                if ((stepObject->distanceGrid.h == gridLoc.h) &&
-                    (stepObject->distanceGrid.v == gridLoc.v)) {
-                    otherDestObject = stepObject;
-                }
-                stepObject = stepObject->nextFarObject;
-            }
-            if (otherDestObject->owner == anObject->owner) {
-                friendValue = otherDestObject->localFriendStrength;
-                foeValue    = otherDestObject->localFoeStrength;
-            } else {
-                foeValue    = otherDestObject->localFriendStrength;
-                friendValue = otherDestObject->localFoeStrength;
-            }
-
-            thisValue = kUnimportantTarget;
-            if (destObject->owner == anObject->owner) {
-                if (destObject->attributes & kIsDestination) {
-                    if (destObject->escortStrength < destObject->base->ai.escort.need) {
-                        thisValue = kAbsolutelyEssential;
-                    } else if (foeValue != Fixed::zero()) {
-                        if (foeValue >= friendValue) {
-                            thisValue = kMostImportantTarget;
-                        } else if (foeValue > (friendValue >> 1)) {
-                            thisValue = kVeryImportantTarget;
-                        } else {
-                            thisValue = kUnimportantTarget;
-                        }
-                    } else {
-                        if ((_blitzkrieg > 0) && (anObject->duty == eGuardDuty)) {
-                            thisValue = kUnimportantTarget;
-                        } else {
-                            if (foeValue > Fixed::zero()) {
-                                thisValue = kSomewhatImportantTarget;
-                            } else {
-                                thisValue = kUnimportantTarget;
-                            }
-                        }
-                    }
-                    if (anObject->base->orderFlags & kSoftTargetIsBase) {
-                        thisValue <<= 3;
-                    }
-                    if (anObject->base->orderFlags & kHardTargetIsNotBase) {
-                        thisValue = Fixed::zero();
-                    }
-                } else {
-                    if (destObject->base->ai.escort.class_ > anObject->base->ai.escort.class_) {
-                        if (foeValue > friendValue) {
-                            thisValue = kMostImportantTarget;
-                        } else {
-                            if (destObject->escortStrength < destObject->base->ai.escort.need) {
-                                thisValue = kMostImportantTarget;
-                            } else {
-                                thisValue = kUnimportantTarget;
-                            }
-                        }
-                    } else {
-                        thisValue = kUnimportantTarget;
-                    }
-                    if (anObject->base->orderFlags & kSoftTargetIsNotBase) {
-                        thisValue <<= 3;
-                    }
-                    if (anObject->base->orderFlags & kHardTargetIsBase) {
-                        thisValue = Fixed::zero();
-                    }
-                }
-                if (anObject->base->orderFlags & kSoftTargetIsFriend) {
-                    thisValue <<= 3;
-                }
-                if (anObject->base->orderFlags & kHardTargetIsFoe) {
-                    thisValue = Fixed::zero();
-                }
-            } else if (destObject->owner.get()) {
-                if ((anObject->duty == eGuardDuty) || (anObject->duty == eNoDuty)) {
-                    if (destObject->attributes & kIsDestination) {
-                        if (foeValue < friendValue) {
-                            thisValue = kMostImportantTarget;
-                        } else {
-                            thisValue = kSomewhatImportantTarget;
-                        }
-                        if (_blitzkrieg > 0) {
-                            thisValue <<= 2;
-                        }
-                        if (anObject->base->orderFlags & kSoftTargetIsBase) {
-                            thisValue <<= 3;
-                        }
-
-                        if (anObject->base->orderFlags & kHardTargetIsNotBase) {
-                            thisValue = Fixed::zero();
-                        }
-                    } else {
-                        if (friendValue != Fixed::zero()) {
-                            if (friendValue < foeValue) {
-                                thisValue = kSomewhatImportantTarget;
-                            } else {
-                                thisValue = kUnimportantTarget;
-                            }
-                        } else {
-                            thisValue = kLeastImportantTarget;
-                        }
-                        if (anObject->base->orderFlags & kSoftTargetIsNotBase) {
-                            thisValue <<= 1;
-                        }
-
-                        if (anObject->base->orderFlags & kHardTargetIsBase) {
-                            thisValue = Fixed::zero();
-                        }
-                    }
-                }
-                if (anObject->base->orderFlags & kSoftTargetIsFoe) {
-                    thisValue <<= 3;
-                }
-                if (anObject->base->orderFlags & kHardTargetIsFriend) {
-                    thisValue = Fixed::zero();
-                }
-            } else {
-                if (destObject->attributes & kIsDestination) {
-                    thisValue = kVeryImportantTarget;
-                    if (_blitzkrieg > 0) {
-                        thisValue <<= 2;
-                    }
-                    if (anObject->base->orderFlags & kSoftTargetIsBase) {
-                        thisValue <<= 3;
-                    }
-                    if (anObject->base->orderFlags & kHardTargetIsNotBase) {
-                        thisValue = Fixed::zero();
-                    }
-                } else {
-                    if (anObject->base->orderFlags & kSoftTargetIsNotBase) {
-                        thisValue <<= 3;
-                    }
-                    if (anObject->base->orderFlags & kHardTargetIsBase) {
-                        thisValue = Fixed::zero();
-                    }
-                }
-                if (anObject->base->orderFlags & kSoftTargetIsFoe) {
-                    thisValue <<= 3;
-                }
-                if (anObject->base->orderFlags & kHardTargetIsFriend) {
-                    thisValue = Fixed::zero();
-                }
-            }
-
-            difference =
-                    ABS(implicit_cast<int32_t>(destObject->location.h) -
-                        implicit_cast<int32_t>(anObject->location.h));
-            gridLoc.h = difference;
-            difference =
-                    ABS(implicit_cast<int32_t>(destObject->location.v) -
-                        implicit_cast<int32_t>(anObject->location.v));
-            gridLoc.v = difference;
-
-            if ((gridLoc.h < kMaximumRelevantDistance) && (gridLoc.v < kMaximumRelevantDistance)) {
-                if (anObject->base->orderFlags & kSoftTargetIsLocal) {
-                    thisValue <<= 3;
-                }
-                if (anObject->base->orderFlags & kHardTargetIsRemote) {
-                    thisValue = Fixed::zero();
-                }
-            } else {
-                if (anObject->base->orderFlags & kSoftTargetIsRemote) {
-                    thisValue <<= 3;
-                }
-                if (anObject->base->orderFlags & kHardTargetIsLocal) {
-                    thisValue = Fixed::zero();
-                }
-            }
-
-            if (anObject->base->orderFlags & kSoftTargetMatchesTags) {
-                if (tags_match(*destObject->base, anObject->base->ai.target.prefer.tags)) {
-                    thisValue <<= 3;
-                }
-            }
-            if (anObject->base->orderFlags & kHardTargetMatchesTags) {
-                if (!tags_match(*destObject->base, anObject->base->ai.target.force.tags)) {
-                    thisValue = Fixed::zero();
-                }
-            }
+            local_strength(destObject, this, &friendValue, &foeValue);
+            thisValue = target_value(anObject, destObject, friendValue, foeValue, _blitzkrieg);
 
             if (thisValue > Fixed::zero()) {
                 thisValue += anObject->randomSeed.next(thisValue >> 1) - (thisValue >> 2);
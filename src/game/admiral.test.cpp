@@ -0,0 +1,160 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/admiral.hpp"
+
+#include <gmock/gmock.h>
+
+#include "data/base-object.hpp"
+#include "game/globals.hpp"
+#include "game/space-object.hpp"
+#include "math/units.hpp"
+
+using testing::Eq;
+
+namespace antares {
+namespace {
+
+class AdmiralTest : public testing::Test {
+  public:
+    AdmiralTest() {
+        Admiral::init();
+        g.objects.reset();
+        ResetAllSpaceObjects(kMaxSpaceObject);
+
+        ship->base         = &ship_base;
+        ship->owner        = Handle<Admiral>(0);
+        ship->duty         = eNoDuty;
+        planet->base       = &planet_base;
+        planet->owner      = Handle<Admiral>(0);
+        planet->location   = ship->location;
+        planet->attributes = kIsDestination;
+    }
+
+    // Value of `planet` to `ship` when `friend_` and `foe` are the strengths near `planet`.
+    Fixed value(double friend_, double foe, int32_t blitzkrieg = 0) {
+        return target_value(
+                ship, planet, Fixed::from_float(friend_), Fixed::from_float(foe), blitzkrieg);
+    }
+
+    BaseObject          ship_base;
+    BaseObject          planet_base;
+    Handle<SpaceObject> ship{0};
+    Handle<SpaceObject> planet{1};
+};
+
+TEST_F(AdmiralTest, OwnBaseNeedingEscort) {
+    planet_base.ai.escort.need = Fixed::from_float(2.0);
+    planet->escortStrength     = Fixed::from_float(1.0);
+    EXPECT_THAT(value(8.0, 0.0), Eq(Fixed::from_float(128.0)));
+
+    // Once the escort is sufficient, an unthreatened base is worth nothing.
+    planet->escortStrength = Fixed::from_float(2.0);
+    EXPECT_THAT(value(8.0, 0.0), Eq(Fixed::zero()));
+}
+
+TEST_F(AdmiralTest, OwnBaseUnderThreat) {
+    EXPECT_THAT(value(1.0, 1.0), Eq(Fixed::from_float(2.0)));    // outmatched
+    EXPECT_THAT(value(1.0, 0.75), Eq(Fixed::from_float(1.375)));  // threatened
+    EXPECT_THAT(value(1.0, 0.25), Eq(Fixed::zero()));             // safe
+
+    ship_base.orderFlags = kSoftTargetIsBase;
+    EXPECT_THAT(value(1.0, 1.0), Eq(Fixed::from_float(16.0)));
+    ship_base.orderFlags = kSoftTargetIsBase | kHardTargetIsNotBase;
+    EXPECT_THAT(value(1.0, 1.0), Eq(Fixed::zero()));
+}
+
+TEST_F(AdmiralTest, EnemyBase) {
+    planet->owner = Handle<Admiral>(1);
+    EXPECT_THAT(value(2.0, 1.0), Eq(Fixed::from_float(2.0)));
+    EXPECT_THAT(value(1.0, 2.0), Eq(Fixed::from_float(1.125)));
+    EXPECT_THAT(value(1.0, 2.0, 1), Eq(Fixed::from_float(4.5)));
+
+    ship_base.orderFlags = kSoftTargetIsBase;
+    EXPECT_THAT(value(2.0, 1.0, 1), Eq(Fixed::from_float(64.0)));
+    ship_base.orderFlags = kHardTargetIsFriend;
+    EXPECT_THAT(value(2.0, 1.0), Eq(Fixed::zero()));
+
+    // Only ships on guard duty or with no duty go after enemy bases.
+    ship_base.orderFlags = 0;
+    ship->duty           = eEscortDuty;
+    EXPECT_THAT(value(2.0, 1.0), Eq(Fixed::zero()));
+}
+
+TEST_F(AdmiralTest, UnownedBase) {
+    planet->owner = Handle<Admiral>();
+    EXPECT_THAT(value(0.0, 0.0), Eq(Fixed::from_float(1.375)));
+    EXPECT_THAT(value(0.0, 0.0, 1), Eq(Fixed::from_float(5.5)));
+
+    ship_base.orderFlags = kSoftTargetIsBase;
+    EXPECT_THAT(value(0.0, 0.0), Eq(Fixed::from_float(11.0)));
+}
+
+TEST_F(AdmiralTest, RemoteBase) {
+    planet->owner = Handle<Admiral>();
+    planet->location.h += kMaximumRelevantDistance;
+
+    ship_base.orderFlags = kSoftTargetIsRemote;
+    EXPECT_THAT(value(0.0, 0.0), Eq(Fixed::from_float(11.0)));
+    ship_base.orderFlags = kHardTargetIsLocal;
+    EXPECT_THAT(value(0.0, 0.0), Eq(Fixed::zero()));
+    ship_base.orderFlags = kSoftTargetIsLocal;
+    EXPECT_THAT(value(0.0, 0.0), Eq(Fixed::from_float(1.375)));
+}
+
+TEST_F(AdmiralTest, LocalStrength) {
+    // Far list: planet -> a -> b -> c. `a` and `c` share planet's cell; `c` is last, and holds
+    // the strengths for the cell, as reckoned by its owner.
+    Handle<SpaceObject> a(2), b(3), c(4);
+    planet->distanceGrid  = Point{32766, 32768};
+    a->distanceGrid       = Point{32766, 32768};
+    b->distanceGrid       = Point{32770, 32768};
+    c->distanceGrid       = Point{32766, 32768};
+    planet->nextFarObject = a;
+    a->nextFarObject      = b;
+    b->nextFarObject      = c;
+    c->nextFarObject      = Handle<SpaceObject>(5);
+
+    a->localFriendStrength = Fixed::from_float(9.0);
+    b->localFriendStrength = Fixed::from_float(9.0);
+    c->localFriendStrength = Fixed::from_float(3.0);
+    c->localFoeStrength    = Fixed::from_float(5.0);
+    c->owner               = Handle<Admiral>(0);
+
+    Fixed friend_, foe;
+    local_strength(planet, Admiral::get(0), &friend_, &foe);
+    EXPECT_THAT(friend_, Eq(Fixed::from_float(3.0)));
+    EXPECT_THAT(foe, Eq(Fixed::from_float(5.0)));
+
+    local_strength(planet, Admiral::get(1), &friend_, &foe);
+    EXPECT_THAT(friend_, Eq(Fixed::from_float(5.0)));
+    EXPECT_THAT(foe, Eq(Fixed::from_float(3.0)));
+}
+
+TEST_F(AdmiralTest, LocalStrengthAlone) {
+    // With no far list, the object is its own cell.
+    planet->localFriendStrength = Fixed::from_float(1.0);
+    planet->localFoeStrength    = Fixed::from_float(2.0);
+
+    Fixed friend_, foe;
+    local_strength(planet, Admiral::get(0), &friend_, &foe);
+    EXPECT_THAT(friend_, Eq(Fixed::from_float(1.0)));
+    EXPECT_THAT(foe, Eq(Fixed::from_float(2.0)));
+}
+
+}  // namespace
+}  // namespace antares
@@ -18,6 +18,9 @@
 
 #include "game/condition.hpp"
 
+#include <algorithm>
+#include <functional>
+
 #include "data/condition.hpp"
 #include "data/plugin.hpp"
 #include "game/action.hpp"
@@ -28,7 +31,10 @@
 #include "game/messages.hpp"
 #include "game/player-ship.hpp"
 #include "game/space-object.hpp"
+#include "game/sys.hpp"
+#include "lang/defines.hpp"
 #include "math/macros.hpp"
+#include "video/driver.hpp"
 
 namespace antares {
 
@@ -182,7 +188,7 @@ static bool is_true(const TargetCondition& c) {
                  std::make_pair(dObject, dObject->id));
 }
 
-static bool is_true(const TimeCondition& c) {
+static game_ticks threshold(const TimeCondition& c) {
     game_ticks t = game_ticks{c.duration};
     if (c.legacy_start_time.value_or(false)) {
         // Tricky: the original code for handling startTime counted g.time in major ticks,
@@ -194,9 +200,11 @@ static bool is_true(const TimeCondition& c) {
             t = game_ticks{c.duration - (g.level->base.start_time.value_or(secs(0)) / 3)};
         }
     }
-    return op_compare(c.op, g.time, t);
+    return t;
 }
 
+static bool is_true(const TimeCondition& c) { return op_compare(c.op, g.time, threshold(c)); }
+
 static bool is_true(const ZoomCondition& c) { return op_compare(c.op, g.zoom, c.value); }
 
 static bool is_true(const ConditionWhen& c) {
@@ -222,13 +230,83 @@ static bool is_true(const ConditionWhen& c) {
     }
 }
 
+// Returns the earliest time that `c` could possibly be true.
+//
+// This is only known for conditions that depend on nothing but the clock, which only moves
+// forwards. Anything else could become true at any time, so returns the beginning of time.
+static game_ticks earliest_true(const ConditionWhen& c) {
+    switch (c.type()) {
+        case ConditionWhen::Type::NONE: return game_ticks::max();
+        case ConditionWhen::Type::TIME:
+            switch (c.time.op) {
+                case ConditionOp::EQ:
+                case ConditionOp::GE: return threshold(c.time);
+                case ConditionOp::GT: return threshold(c.time) + ticks(1);
+                default: break;
+            }
+            break;
+        default: break;
+    }
+    return game_ticks::min();
+}
+
+// Tracks which conditions CheckLevelConditions() needs to look at.
+//
+// Conditions that can't be true until some later time sleep in a min-heap keyed by that time,
+// and wake into `awake` once the clock reaches it. `awake` is kept in level order, since
+// conditions are checked in that order, and one can enable or disable another. Which conditions
+// are awake depends only on the level and the time, so if either changes other than by the clock
+// moving forwards (a new level, or a snapshot being restored), the schedule is rebuilt.
+struct ConditionSchedule {
+    typedef std::pair<game_ticks, int> Deadline;
+
+    const Level*          level = nullptr;
+    game_ticks            time;
+    std::vector<Deadline> sleeping;
+    std::vector<int>      awake;
+};
+static ANTARES_GLOBAL ConditionSchedule schedule;
+
+static void wake_conditions() {
+    if ((schedule.level != g.level) || (g.time < schedule.time)) {
+        schedule.level = g.level;
+        schedule.sleeping.clear();
+        schedule.awake.clear();
+        for (auto& c : g.level->base.conditions) {
+            int index = (&c - g.level->base.conditions.data());
+            schedule.sleeping.emplace_back(earliest_true(c.when), index);
+        }
+        std::make_heap(
+                schedule.sleeping.begin(), schedule.sleeping.end(),
+                std::greater<ConditionSchedule::Deadline>());
+    }
+    schedule.time = g.time;
+
+    bool woke = false;
+    while (!schedule.sleeping.empty() && (schedule.sleeping.front().first <= g.time)) {
+        std::pop_heap(
+                schedule.sleeping.begin(), schedule.sleeping.end(),
+                std::greater<ConditionSchedule::Deadline>());
+        schedule.awake.push_back(schedule.sleeping.back().second);
+        schedule.sleeping.pop_back();
+        woke = true;
+    }
+    if (woke) {
+        std::sort(schedule.awake.begin(), schedule.awake.end());
+    }
+}
+
 void CheckLevelConditions() {
-    for (auto& c : g.level->base.conditions) {
-        int index = (&c - g.level->base.conditions.data());
+    wake_conditions();
+    // Indexed rather than iterated, since actions might check conditions again.
+    for (size_t i = 0; i < schedule.awake.size(); ++i) {
+        int              index = schedule.awake[i];
+        const Condition& c     = g.level->base.conditions[index];
         if (g.condition_enabled[index] && is_true(c.when)) {
             if (!c.persistent.value_or(false)) {
                 g.condition_enabled[index] = false;
             }
+            sys.video->trigger_snapshot(SnapshotTrigger::CONDITION_FIRED);
             auto subject = resolve_object_ref(c.subject);
             auto direct  = resolve_object_ref(c.direct);
             exec(c.action, subject, direct, {0, 0});
@@ -102,7 +102,10 @@ game_ticks RealInputSource::at() {
 }
 
 ReplayInputSource::ReplayInputSource(ReplayData* data)
-        : _duration(game_ticks(ticks(data->duration * 3))), _exit(false) {
+        : _data(data),
+          _sync_mode(IGNORE_SYNCS),
+          _duration(game_ticks(ticks(data->duration * 3))),
+          _exit(false) {
     for (auto action : data->actions) {
         game_ticks at = game_ticks(ticks(action.at * 3));
         for (auto key : action.keys_down) {
@@ -118,12 +121,21 @@ ReplayInputSource::ReplayInputSource(ReplayData* data)
     }
 }
 
+void ReplayInputSource::record_syncs(uint64_t interval) {
+    _data->sync_interval = interval;
+    _data->syncs.clear();
+    _sync_mode = RECORD_SYNCS;
+}
+
+void ReplayInputSource::verify_syncs() { _sync_mode = VERIFY_SYNCS; }
+
 void ReplayInputSource::start() {}
 
 bool ReplayInputSource::get(Handle<Admiral> admiral, game_ticks at, EventReceiver& receiver) {
     if (_exit || (at >= _duration)) {
         return false;
     }
+    check_sync(at);
     auto events = _events.equal_range(make_pair(admiral.number(), at));
     for (auto it : range(events.first, events.second)) {
         it->second->send(&receiver);
@@ -131,6 +143,26 @@ bool ReplayInputSource::get(Handle<Admiral> admiral, game_ticks at, EventReceive
     return true;
 }
 
+// Syncs are taken at the same point in each major tick, before that tick's input is applied.
+// Replay ticks are major ticks, so tick `n` of the replay is at game time `n * 3`.
+void ReplayInputSource::check_sync(game_ticks at) {
+    if ((_sync_mode == IGNORE_SYNCS) || (_data->sync_interval == 0)) {
+        return;
+    }
+    const uint64_t tick = at.time_since_epoch().count() / 3;
+    if ((tick == 0) || ((tick % _data->sync_interval) != 0)) {
+        return;
+    }
+    const size_t index = (tick / _data->sync_interval) - 1;
+    if (_sync_mode == RECORD_SYNCS) {
+        if (index == _data->syncs.size()) {
+            _data->syncs.push_back(g.sync);
+        }
+    } else if ((index < _data->syncs.size()) && (_data->syncs[index] != g.sync)) {
+        throw std::runtime_error(pn::format("replay out of sync at tick {0}", tick).c_str());
+    }
+}
+
 void ReplayInputSource::key_down(const KeyDownEvent& event) { _exit = true; }
 
 void ReplayInputSource::gamepad_button_down(const GamepadButtonDownEvent& event) { _exit = true; }
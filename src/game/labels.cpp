@@ -26,6 +26,7 @@
 #include "game/admiral.hpp"
 #include "game/cursor.hpp"
 #include "game/globals.hpp"
+#include "game/sim-stats.hpp"
 #include "game/space-object.hpp"
 #include "game/sys.hpp"
 #include "lang/defines.hpp"
@@ -57,28 +58,30 @@ Label* Label::get(int number) {
     return nullptr;
 }
 
-void Label::init() { g.labels.reset(new Label[kMaxLabelNum]); }
+UsedHandleList<Label> Label::live() { return UsedHandleList<Label>(g.label_slots); }
+
+void Label::init() {
+    g.labels.reset(new Label[kMaxLabelNum]);
+    g.label_slots.reset(kMaxLabelNum);
+}
 
 void Label::reset() {
     for (auto label : all()) {
         *label = Label();
     }
+    g.label_slots.reset(kMaxLabelNum);
 }
 
-Handle<Label> Label::next_free_label() {
-    for (auto label : all()) {
-        if (!label->active) {
-            return label;
-        }
-    }
-    return Label::none();
-}
+Handle<Label> Label::next_free_label() { return Handle<Label>(g.label_slots.allocate()); }
 
 Handle<Label> Label::add(
         int16_t h, int16_t v, int16_t hoff, int16_t voff, Handle<SpaceObject> object,
         bool objectLink, Hue hue) {
     auto label = next_free_label();
     if (!label.get()) {
+        if (sys.sim_stats) {
+            ++sys.sim_stats->labels.dropped;
+        }
         return Label::none();  // no free label
     }
 
@@ -102,6 +105,8 @@ Handle<Label> Label::add(
     return label;
 }
 
+int32_t Label::used() { return g.label_slots.used(); }
+
 void Label::remove() {
     thisRect = Rect(0, 0, -1, -1);
     _text    = StyledText{};
@@ -109,17 +114,18 @@ void Label::remove() {
     killMe   = false;
     object   = SpaceObject::none();
     lineNum  = 0;
+    g.label_slots.release(this - g.labels.get());
 }
 
 void Label::draw() {
-    for (auto label : all()) {
+    for (auto label : live()) {
         // We anchor the image at the corner of the rect instead of label->where.  In some cases,
         // label->where is changed between update_all_label_contents() and draw time, but the rect
         // remains unchanged.  Since that function used to do this drawing, the rect's corner is
         // the original location we drew at.
         Rect rect = label->thisRect;
 
-        if (!label->active || label->killMe || label->_text.empty() || !label->visible ||
+        if (label->killMe || label->_text.empty() || !label->visible ||
             (label->thisRect.width() <= 0) || (label->thisRect.height() <= 0)) {
             continue;
         }
@@ -133,8 +139,8 @@ void Label::draw() {
 
 void Label::update_contents(ticks units_done) {
     Rect clip = viewport();
-    for (auto label : all()) {
-        if (!label->active || label->killMe || label->_text.empty() || !label->visible) {
+    for (auto label : live()) {
+        if (label->killMe || label->_text.empty() || !label->visible) {
             label->thisRect.left = label->thisRect.right = 0;
             continue;
         }
@@ -162,10 +168,11 @@ void Label::update_contents(ticks units_done) {
 }
 
 void Label::show_all() {
-    for (auto label : all()) {
-        if (label->active && label->visible) {
+    for (auto label : live()) {
+        if (label->visible) {
             if (label->killMe) {
                 label->active = false;
+                g.label_slots.release(label.number());
             }
         }
     }
@@ -181,9 +188,9 @@ void Label::update_positions(ticks units_done) {
             viewport().left + kLabelBuffer, viewport().top + kLabelBuffer,
             viewport().right - kLabelBuffer, viewport().bottom - kLabelBuffer);
 
-    for (auto label : all()) {
+    for (auto label : live()) {
         bool isOffScreen = false;
-        if ((label->active) && (!label->killMe)) {
+        if (!label->killMe) {
             if (label->object.get() && label->object->sprite.get()) {
                 if (label->object->active) {
                     label->where.h = label->object->sprite->where.h + label->offset.h;
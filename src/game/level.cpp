@@ -58,7 +58,7 @@ enum class Required : bool {
     YES = true,
 };
 
-void AddBaseObjectActionMedia(const std::vector<Action>& actions, std::bitset<16> all_colors);
+void AddBaseObjectActionMedia(const ActionList& actions, std::bitset<16> all_colors);
 void AddActionMedia(const Action& action, std::bitset<16> all_colors);
 
 void AddBaseObjectMedia(
@@ -112,7 +112,7 @@ void AddBaseObjectMedia(
     }
 }
 
-void AddBaseObjectActionMedia(const std::vector<Action>& actions, std::bitset<16> all_colors) {
+void AddBaseObjectActionMedia(const ActionList& actions, std::bitset<16> all_colors) {
     for (const auto& action : actions) {
         AddActionMedia(action, all_colors);
     }
@@ -183,11 +183,12 @@ static void construct_players(const Players& players) {
     }
 }
 
-LoadState start_construct_level(const Level& level) {
-    ResetAllSpaceObjects();
+LoadState start_construct_level(const Level& level, sfz::optional<int32_t> capacity_override) {
+    const int32_t capacity = object_capacity(level, capacity_override);
+    ResetAllSpaceObjects(capacity);
     reset_action_queue();
-    Vectors::reset();
-    ResetAllSprites();
+    Vectors::reset(capacity);
+    ResetAllSprites(capacity);
     Label::reset();
     ResetInstruments();
     Admiral::reset();
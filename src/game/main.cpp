@@ -49,7 +49,10 @@
 #include "game/motion.hpp"
 #include "game/non-player-ship.hpp"
 #include "game/player-ship.hpp"
+#include "game/sim-stats.hpp"
+#include "game/space-object.hpp"
 #include "game/starfield.hpp"
+#include "game/state-hash.hpp"
 #include "game/sys.hpp"
 #include "game/time.hpp"
 #include "game/vector.hpp"
@@ -234,6 +237,154 @@ GamePlay::GamePlay(bool replay, InputSource* input, GameResult* game_result)
           _real_time(now()),
           _input_source(input) {}
 
+// Advances the simulation by `units`, which must not cross a major tick boundary. Only updates
+// state that affects the outcome of the game; the caller is responsible for the starfield,
+// labels, vectors, radar, and anything else that is only drawn.
+//
+// Returns true if a major tick was executed.
+static bool simulate(ticks units, InputSource* input_source, PlayerShip& player_ship) {
+    MoveSpaceObjects(units);
+
+    g.time += units;
+
+    bool major_tick = ((g.time.time_since_epoch() % kMajorTick) == ticks(0));
+    if (major_tick) {
+        // everything in here gets executed once every major tick
+        NonplayerShipThink();
+        AdmiralThink();
+        execute_action_queue();
+
+        InvalidateManualSelectIndex();
+        if (!input_source->get(g.admiral, g.time, player_ship)) {
+            g.game_over    = true;
+            g.game_over_at = g.time;
+        }
+        player_ship.update();
+
+        CollideSpaceObjects();
+        if ((g.time.time_since_epoch() % kConditionTick) == ticks(0)) {
+            CheckLevelConditions();
+        }
+
+        if (sys.state_hash) {
+            sys.state_hash->record();
+        }
+        if (sys.sim_stats) {
+            sys.sim_stats->sample();
+        }
+#ifndef NDEBUG
+        CheckObjectCounts();
+#endif
+    }
+
+    UpdateMiniScreenLines();
+    return major_tick;
+}
+
+static bool game_finished() { return g.game_over && (g.time >= g.game_over_at); }
+
+static GameResult finished_game_result() {
+    return (g.victor == g.admiral) ? WIN_GAME : LOSE_GAME;
+}
+
+// Puts every computer admiral in `ai` mode, replacing the mode from the level.
+static void override_ai(LevelBase::AIMode ai) {
+    for (auto a : Admiral::all()) {
+        if (!a->active() || !(a->attributes() & kAIsComputer) || (a->attributes() & kAIsRemote)) {
+            continue;
+        }
+        switch (ai) {
+            case LevelBase::AIMode::LEGACY: a->attributes() &= ~kAIsPlanner; break;
+            case LevelBase::AIMode::PLANNER: a->attributes() |= kAIsPlanner; break;
+        }
+    }
+}
+
+static void start_sim_only(
+        const Level& level, sfz::optional<int32_t> object_capacity = sfz::nullopt,
+        sfz::optional<LevelBase::AIMode> ai = sfz::nullopt) {
+    RemoveAllSpaceObjects();
+    g.game_over = false;
+
+    LoadState s = start_construct_level(level, object_capacity);
+    while (!s.done) {
+        construct_level(&s);
+    }
+    if (ai.has_value()) {
+        override_ai(*ai);
+    }
+    set_up_instruments();
+}
+
+// Step one minor tick at a time, as EventScheduler does when it drives GamePlay, so that the
+// simulation matches a replay run through a video driver exactly.
+static void step_sim_only(InputSource* input, PlayerShip& player_ship) {
+    simulate(kMinorTick, input, player_ship);
+
+    // Not drawn, but sprite and vector slots are limited, and running out of them affects the
+    // game, so they still need to be reclaimed (as in run_game_1s()).
+    CullSprites();
+    Vectors::cull();
+}
+
+GameResult play_sim_only(
+        const Level& level, InputSource* input, sfz::optional<LevelBase::AIMode> ai) {
+    start_sim_only(level, sfz::nullopt, ai);
+    PlayerShip player_ship;
+    input->start();
+    CheckLevelConditions();
+
+    while (!game_finished()) {
+        step_sim_only(input, player_ship);
+    }
+    return finished_game_result();
+}
+
+SimSeeker::SimSeeker(
+        const Level& level, InputSource* input, ticks keyframe_interval,
+        sfz::optional<int32_t> object_capacity)
+        : _input{input}, _keyframe_interval{keyframe_interval} {
+    if ((keyframe_interval < ticks(0)) || ((keyframe_interval % kMajorTick) != ticks(0))) {
+        throw std::runtime_error("keyframe interval must be a non-negative multiple of 3 ticks");
+    }
+
+    start_sim_only(level, object_capacity);
+    _player_ship.reset(new PlayerShip);
+    _input->start();
+    CheckLevelConditions();
+    _keyframes.emplace(g.time, Snapshot(*_player_ship));
+}
+
+SimSeeker::~SimSeeker() {}
+
+void SimSeeker::seek(game_ticks t) {
+    // Restore the latest keyframe at or before `t`, unless the simulation is already between
+    // that keyframe and `t`, in which case continuing from here is less work.
+    auto it = _keyframes.upper_bound(t);
+    if (it != _keyframes.begin()) {
+        --it;
+        if ((g.time < it->first) || (g.time > t)) {
+            it->second.restore(*_player_ship);
+        }
+    }
+    while ((g.time < t) && !game_finished()) {
+        step();
+    }
+}
+
+bool SimSeeker::finished() const { return game_finished(); }
+
+GameResult SimSeeker::result() const { return finished_game_result(); }
+
+void SimSeeker::step() {
+    step_sim_only(_input, *_player_ship);
+    if ((_keyframe_interval > ticks(0)) &&
+        ((g.time.time_since_epoch() % _keyframe_interval) == ticks(0)) &&
+        !_keyframes.count(g.time)) {
+        _keyframes.emplace(g.time, Snapshot(*_player_ship));
+    }
+}
+
 static const usecs kSwitchAfter = usecs(1000000 / 3);  // TODO(sfiera): ticks(20)
 static const usecs kSleepAfter  = secs(60);
 
@@ -454,32 +605,11 @@ void GamePlay::fire_timer() {
         // executed arbitrarily, but at least once every major tick
         globals()->starfield.prepare_to_move();
         globals()->starfield.move(unitsToDo);
-        MoveSpaceObjects(unitsToDo);
 
-        g.time += unitsToDo;
-
-        if ((g.time.time_since_epoch() % kMajorTick) == ticks(0)) {
-            // everything in here gets executed once every major tick
+        if (simulate(unitsToDo, _input_source, _player_ship)) {
             _player_paused = false;
-
-            NonplayerShipThink();
-            AdmiralThink();
-            execute_action_queue();
-
-            if (!_input_source->get(g.admiral, g.time, _player_ship)) {
-                g.game_over    = true;
-                g.game_over_at = g.time;
-            }
-            _player_ship.update();
-
-            CollideSpaceObjects();
-            if ((g.time.time_since_epoch() % kConditionTick) == ticks(0)) {
-                CheckLevelConditions();
-            }
         }
 
-        UpdateMiniScreenLines();
-
         Messages::clip();
         Messages::draw_long_message(unitsToDo);
 
@@ -501,14 +631,8 @@ void GamePlay::fire_timer() {
         unitsPassed -= unitsToDo;
     }
 
-    if (g.game_over && (g.time >= g.game_over_at)) {
-        if (*_game_result == NO_GAME) {
-            if (g.victor == g.admiral) {
-                *_game_result = WIN_GAME;
-            } else {
-                *_game_result = LOSE_GAME;
-            }
-        }
+    if (game_finished() && (*_game_result == NO_GAME)) {
+        *_game_result = finished_game_result();
     }
 
     switch (*_game_result) {
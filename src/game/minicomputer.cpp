@@ -798,7 +798,8 @@ void build_ship(Handle<Admiral> adm, int32_t index) {
     if (g.key_mask & kComputerBuildMenu) {
         return;
     }
-    if (CountObjectsOfBaseType(nullptr, Admiral::none()) < (kMaxSpaceObject - kMaxShipBuffer)) {
+    if (CountObjectsOfBaseType(nullptr, Admiral::none()) <
+        (g.object_slots.capacity() - kMaxShipBuffer)) {
         if (adm->build(index) == false) {
             if (adm == g.admiral) {
                 sys.sound.warning();
@@ -18,6 +18,9 @@
 
 #include "game/motion.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #include "data/base-object.hpp"
 #include "drawing/color.hpp"
 #include "drawing/pix-table.hpp"
@@ -30,6 +33,7 @@
 #include "game/space-object.hpp"
 #include "game/vector.hpp"
 #include "lang/defines.hpp"
+#include "math/kinematics.hpp"
 #include "math/macros.hpp"
 #include "math/random.hpp"
 #include "math/rotation.hpp"
@@ -67,13 +71,13 @@ const Rect    kThinkiverse{
 //     2 3 4
 //
 // The point of this is, if we iterate through a grid such as
-// {near,far}_objects, and at each cell, check the cell at each of these
+// {near,far}_index, and at each cell, check the cell at each of these
 // relative locations, we will make a pairwise comparison between all
 // adjacent cells exactly once.
 //
 // make_adjacent_cells turns the relative locations to absolute indices,
 // and keeps that information in kAdjacentCells[k].  If the relative
-// location would be outside the 16x16 grid of near_object, then
+// location would be outside the 16x16 grid of near_index, then
 // super_offset gets added to the object in question’s super location.
 // An object is only really in a cell if the super location matches too.
 const static Point kAdjacentUnits[] = {{0, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}};
@@ -132,6 +136,147 @@ static AdjacentCells make_adjacent_cells() {
 
 static const AdjacentCells kAdjacentCells = make_adjacent_cells();
 
+// A spatial hash over one level of the proximity grid (near or far).
+//
+// Each object is keyed by its full grid cell: the index of its cell in the wrap-around 16x16
+// grid, plus its super location (collisionGrid or distanceGrid). Objects are stored in one
+// contiguous array, grouped by cell, and a hash table maps each occupied cell to its range of
+// that array. Unlike a linked list per wrapped cell, objects from far-apart super locations
+// never share a cell, so they are never considered as pairs.
+//
+// for_each_pair() visits pairs in exactly the order that walking the old per-cell linked lists
+// did: by wrapped index, then most recently added first, each paired with the objects after it
+// in its own cell and then with each adjacent cell. HitObject() and friends have side effects,
+// so this order is part of the simulation.
+class ProximityIndex {
+  public:
+    void clear() { _entries.clear(); }
+
+    // Objects must be added in g.root order.
+    void add(Handle<SpaceObject> object, Point super, int32_t index) {
+        _entries.push_back(Entry{object, super, index, static_cast<int32_t>(_entries.size()), 0});
+    }
+
+    void build();
+
+    // Calls f(a, b, k) for each pair, where k is the index of b's cell in kAdjacentCells,
+    // relative to a's; k == 0 means a and b share a cell.
+    template <typename F>
+    void for_each_pair(const F& f) const;
+
+  private:
+    struct Entry {
+        Handle<SpaceObject> object;
+        Point               super;
+        int32_t             index;  // in the wrap-around grid
+        int32_t             rank;   // order added
+        int32_t             end;    // end of this entry’s cell in _entries
+    };
+
+    struct Slot {
+        uint64_t key;
+        int32_t  begin;  // negative for an empty slot
+        int32_t  end;
+    };
+
+    // super.h and super.v are at most 21 bits, because locations are 32 bits and a super cell
+    // is at least 2^11 units wide.
+    static uint64_t key(Point super, int32_t index) {
+        return ((static_cast<uint64_t>(super.h) & 0x1fffff) << 29) |
+               ((static_cast<uint64_t>(super.v) & 0x1fffff) << 8) | index;
+    }
+    static uint64_t key(const Entry& e) { return key(e.super, e.index); }
+
+    uint64_t    hash(uint64_t key) const { return (key * 0x9e3779b97f4a7c15ull) >> 32; }
+    const Slot* find(uint64_t key) const;
+
+    std::vector<Entry>   _entries;
+    std::vector<int32_t> _order;  // indices into _entries, in visiting order
+    std::vector<Slot>    _slots;  // open addressing, with linear probing
+};
+
+void ProximityIndex::build() {
+    // Group entries by cell, most recently added first within each cell.
+    std::sort(_entries.begin(), _entries.end(), [](const Entry& x, const Entry& y) {
+        uint64_t x_key = key(x), y_key = key(y);
+        return (x_key != y_key) ? (x_key < y_key) : (x.rank > y.rank);
+    });
+
+    size_t cells = 0;
+    for (int32_t begin = 0, end; begin < _entries.size(); begin = end) {
+        uint64_t k = key(_entries[begin]);
+        for (end = begin + 1; (end < _entries.size()) && (key(_entries[end]) == k); ++end) {
+        }
+        for (int32_t i = begin; i < end; ++i) {
+            _entries[i].end = end;
+        }
+        ++cells;
+    }
+
+    size_t capacity = 16;
+    while (capacity < (2 * cells)) {
+        capacity <<= 1;
+    }
+    _slots.assign(capacity, Slot{0, -1, -1});
+    for (int32_t begin = 0; begin < _entries.size(); begin = _entries[begin].end) {
+        uint64_t k = key(_entries[begin]);
+        size_t   i = hash(k) & (capacity - 1);
+        while (_slots[i].begin >= 0) {
+            i = (i + 1) & (capacity - 1);
+        }
+        _slots[i] = Slot{k, begin, _entries[begin].end};
+    }
+
+    _order.resize(_entries.size());
+    for (int32_t i = 0; i < _order.size(); ++i) {
+        _order[i] = i;
+    }
+    std::sort(_order.begin(), _order.end(), [this](int32_t x, int32_t y) {
+        const Entry& a = _entries[x];
+        const Entry& b = _entries[y];
+        return (a.index != b.index) ? (a.index < b.index) : (a.rank > b.rank);
+    });
+}
+
+const ProximityIndex::Slot* ProximityIndex::find(uint64_t key) const {
+    size_t mask = _slots.size() - 1;
+    for (size_t i = hash(key) & mask; _slots[i].begin >= 0; i = (i + 1) & mask) {
+        if (_slots[i].key == key) {
+            return &_slots[i];
+        }
+    }
+    return nullptr;
+}
+
+template <typename F>
+void ProximityIndex::for_each_pair(const F& f) const {
+    for (int32_t i : _order) {
+        const Entry& a     = _entries[i];
+        const auto*  cells = kAdjacentCells.at[a.index];
+        for (int32_t k = 0; k < AdjacentCells::size; k++) {
+            int32_t begin = i + 1;
+            int32_t end   = a.end;
+            if (k > 0) {
+                const auto& adj   = cells[k];
+                Point       super = a.super;
+                super.offset(adj.super_offset.h, adj.super_offset.v);
+                const Slot* slot = find(key(super, adj.index_offset));
+                if (!slot) {
+                    continue;
+                }
+                begin = slot->begin;
+                end   = slot->end;
+            }
+            for (int32_t j = begin; j < end; ++j) {
+                f(a.object, _entries[j].object, k);
+            }
+        }
+    }
+}
+
+static ANTARES_GLOBAL ProximityIndex near_index;
+static ANTARES_GLOBAL ProximityIndex far_index;
+
 ANTARES_GLOBAL ScaledScreen scaled_screen;
 
 static void correct_physical_space(SpaceObject* a, SpaceObject* b);
@@ -148,57 +293,156 @@ void ResetMotionGlobals() {
     g.farthest           = Handle<SpaceObject>(0);
 }
 
-static void move_object(SpaceObject* o) {
-    if ((o->maxVelocity == Fixed::zero()) && !(o->attributes & kCanTurn)) {
-        return;
-    }
+// The kinematic state of each object that MoveSpaceObjects() moves, as parallel arrays in
+// g.root order. MoveSpaceObjects() loads it from the objects, steps it once per tick, and then
+// stores it back, so that the innermost loop reads a few contiguous arrays instead of following
+// nextObject through whole SpaceObjects. Outside of MoveSpaceObjects(), the fields of
+// SpaceObject are the only copy.
+struct MotionState {
+    std::vector<SpaceObject*> object;
+    std::vector<uint8_t>      moving;  // still kObjectInUse
+    std::vector<uint8_t>      still;   // can neither move nor turn
+    std::vector<uint32_t>     attributes;
+    std::vector<Fixed>        thrust;
+    std::vector<Fixed>        speed;  // maxVelocity, or the warp speed while warping
+    std::vector<int32_t>      direction;
+    std::vector<Fixed>        turn_velocity;
+    std::vector<Fixed>        turn_fraction;
+    std::vector<Fixed>        velocity_h, velocity_v;
+    std::vector<Fixed>        fraction_h, fraction_v;
+    std::vector<int32_t>      location_h, location_v;
+    std::vector<Fixed>        carried_h, carried_v;  // fraction_h and _v, after carry()
+    std::vector<int32_t>      whole_h, whole_v;      // and the whole units carried out
+    std::vector<int32_t>      row;                   // by object number; -1 if not loaded
+
+    void  load();
+    void  carry();
+    void  store();
+    Point location(const SpaceObject& o) const;
+};
+static ANTARES_GLOBAL MotionState motion;
 
-    if (o->attributes & kCanTurn) {
-        o->turnFraction += o->turnVelocity;
+void MotionState::load() {
+    if (row.size() != g.object_slots.capacity()) {
+        row.assign(g.object_slots.capacity(), -1);
+    }
+    object.clear();
+    moving.clear();
+    still.clear();
+    attributes.clear();
+    thrust.clear();
+    speed.clear();
+    direction.clear();
+    turn_velocity.clear();
+    turn_fraction.clear();
+    velocity_h.clear();
+    velocity_v.clear();
+    fraction_h.clear();
+    fraction_v.clear();
+    location_h.clear();
+    location_v.clear();
 
-        int32_t h;
-        if (o->turnFraction >= Fixed::zero()) {
-            h = more_evil_fixed_to_long(o->turnFraction + Fixed::from_float(0.5));
+    SpaceObject* o = nullptr;
+    for (Handle<SpaceObject> o_handle = g.root; (o = o_handle.get()); o_handle = o->nextObject) {
+        if (o->active != kObjectInUse) {
+            continue;
+        }
+        row[o_handle.number()] = object.size();
+        object.push_back(o);
+        moving.push_back(true);
+        still.push_back((o->maxVelocity == Fixed::zero()) && !(o->attributes & kCanTurn));
+        attributes.push_back(o->attributes);
+        thrust.push_back(o->thrust);
+        if (o->presenceState == kWarpingPresence) {
+            speed.push_back(o->presence.warping);
+        } else if (o->presenceState == kWarpOutPresence) {
+            speed.push_back(o->presence.warp_out);
         } else {
-            h = more_evil_fixed_to_long(o->turnFraction - Fixed::from_float(0.5)) + 1;
+            speed.push_back(o->maxVelocity);
         }
-        o->direction += h;
-        o->turnFraction -= Fixed::from_long(h);
+        direction.push_back(o->direction);
+        turn_velocity.push_back(o->turnVelocity);
+        turn_fraction.push_back(o->turnFraction);
+        velocity_h.push_back(o->velocity.h);
+        velocity_v.push_back(o->velocity.v);
+        fraction_h.push_back(o->motionFraction.h);
+        fraction_v.push_back(o->motionFraction.v);
+        location_h.push_back(o->location.h);
+        location_v.push_back(o->location.v);
+    }
+
+    carried_h.resize(object.size());
+    carried_v.resize(object.size());
+    whole_h.resize(object.size());
+    whole_v.resize(object.size());
+}
+
+// Adds velocity to fraction for every object at once, and works out how far each one moves.
+// Rows that aren't moving get carried too, but move_object() ignores them.
+void MotionState::carry() {
+    carry_fractions(
+            object.size(), velocity_h.data(), fraction_h.data(), carried_h.data(), whole_h.data());
+    carry_fractions(
+            object.size(), velocity_v.data(), fraction_v.data(), carried_v.data(), whole_v.data());
+}
+
+void MotionState::store() {
+    for (int32_t i = 0; i < object.size(); ++i) {
+        SpaceObject* o    = object[i];
+        o->direction      = direction[i];
+        o->turnFraction   = turn_fraction[i];
+        o->velocity       = {velocity_h[i], velocity_v[i]};
+        o->motionFraction = {fraction_h[i], fraction_v[i]};
+        o->location       = {location_h[i], location_v[i]};
+        row[o->number()]  = -1;
+    }
+}
+
+Point MotionState::location(const SpaceObject& o) const {
+    int32_t i = row[o.number()];
+    return (i < 0) ? o.location : Point{location_h[i], location_v[i]};
+}
+
+// Turns and thrusts, which only depend on the object's own state.
+static void accelerate_object(MotionState& m, int32_t i) {
+    if (m.still[i]) {
+        return;
+    }
+
+    if (m.attributes[i] & kCanTurn) {
+        Fixed&   turn_fraction = m.turn_fraction[i];
+        int32_t& direction     = m.direction[i];
+        direction += carry_fraction(m.turn_velocity[i], &turn_fraction);
 
-        while (o->direction >= ROT_POS) {
-            o->direction -= ROT_POS;
+        while (direction >= ROT_POS) {
+            direction -= ROT_POS;
         }
-        while (o->direction < 0) {
-            o->direction += ROT_POS;
+        while (direction < 0) {
+            direction += ROT_POS;
         }
     }
 
-    if (o->thrust != Fixed::zero()) {
+    Fixed& velocity_h = m.velocity_h[i];
+    Fixed& velocity_v = m.velocity_v[i];
+    Fixed  thrust     = m.thrust[i];
+    if (thrust != Fixed::zero()) {
         Fixed fa, fb, useThrust;
-        if (o->thrust > Fixed::zero()) {
+        if (thrust > Fixed::zero()) {
             // get the goal dh & dv
-            GetRotPoint(&fa, &fb, o->direction);
-
-            // multiply by max velocity
-            if (o->presenceState == kWarpingPresence) {
-                fa = (fa * o->presence.warping);
-                fb = (fb * o->presence.warping);
-            } else if (o->presenceState == kWarpOutPresence) {
-                fa = (fa * o->presence.warp_out);
-                fb = (fb * o->presence.warp_out);
-            } else {
-                fa = (o->maxVelocity * fa);
-                fb = (o->maxVelocity * fb);
-            }
+            GetRotPoint(&fa, &fb, m.direction[i]);
+
+            // multiply by max velocity (or warp speed)
+            fa = (m.speed[i] * fa);
+            fb = (m.speed[i] * fb);
 
             // the difference between our actual vector and our goal vector is our new vector
-            fa        = fa - o->velocity.h;
-            fb        = fb - o->velocity.v;
-            useThrust = o->thrust;
+            fa        = fa - velocity_h;
+            fb        = fb - velocity_v;
+            useThrust = thrust;
         } else {
-            fa        = -o->velocity.h;
-            fb        = -o->velocity.v;
-            useThrust = -o->thrust;
+            fa        = -velocity_h;
+            fb        = -velocity_v;
+            useThrust = -thrust;
         }
 
         // get the angle of our new vector
@@ -232,53 +476,45 @@ static void move_object(SpaceObject* o) {
             }
         }
 
-        o->velocity.h += fa;
-        o->velocity.v += fb;
+        velocity_h += fa;
+        velocity_v += fb;
     }
+}
 
-    o->motionFraction.h += o->velocity.h;
-    o->motionFraction.v += o->velocity.v;
-
-    int32_t h;
-    if (o->motionFraction.h >= Fixed::zero()) {
-        h = more_evil_fixed_to_long(o->motionFraction.h + Fixed::from_float(0.5));
-    } else {
-        h = more_evil_fixed_to_long(o->motionFraction.h - Fixed::from_float(0.5)) + 1;
-    }
-    o->location.h -= h;
-    o->motionFraction.h -= Fixed::from_long(h);
-
-    int32_t v;
-    if (o->motionFraction.v >= Fixed::zero()) {
-        v = more_evil_fixed_to_long(o->motionFraction.v + Fixed::from_float(0.5));
-    } else {
-        v = more_evil_fixed_to_long(o->motionFraction.v - Fixed::from_float(0.5)) + 1;
+// Moves by the amount that MotionState::carry() worked out.
+static void move_object(MotionState& m, int32_t i) {
+    if (m.still[i]) {
+        return;
     }
-    o->location.v -= v;
-    o->motionFraction.v -= Fixed::from_long(v);
+    m.fraction_h[i] = m.carried_h[i];
+    m.fraction_v[i] = m.carried_v[i];
+    m.location_h[i] -= m.whole_h[i];
+    m.location_v[i] -= m.whole_v[i];
 }
 
-static void bounce_object(SpaceObject* o) {
-    if (!(o->attributes & kDoesBounce)) {
-        if (!kThinkiverse.contains(o->location)) {
-            o->active = kObjectToBeFreed;
+static void bounce_object(MotionState& m, int32_t i) {
+    int32_t& h = m.location_h[i];
+    int32_t& v = m.location_v[i];
+    if (!(m.attributes[i] & kDoesBounce)) {
+        if (!kThinkiverse.contains(Point{h, v})) {
+            m.object[i]->active = kObjectToBeFreed;
         }
         return;
     }
 
-    if (o->location.h < kThinkiverse.left) {
-        o->location.h = kThinkiverse.left;
-        o->velocity.h = -o->velocity.h;
-    } else if (o->location.h >= kThinkiverse.right) {
-        o->location.h = kThinkiverse.right - 1;
-        o->velocity.h = -o->velocity.h;
+    if (h < kThinkiverse.left) {
+        h               = kThinkiverse.left;
+        m.velocity_h[i] = -m.velocity_h[i];
+    } else if (h >= kThinkiverse.right) {
+        h               = kThinkiverse.right - 1;
+        m.velocity_h[i] = -m.velocity_h[i];
     }
-    if (o->location.v < kThinkiverse.top) {
-        o->location.v = kThinkiverse.top;
-        o->velocity.v = -o->velocity.v;
-    } else if (o->location.v >= kThinkiverse.bottom) {
-        o->location.v = kThinkiverse.bottom - 1;
-        o->velocity.v = -o->velocity.v;
+    if (v < kThinkiverse.top) {
+        v               = kThinkiverse.top;
+        m.velocity_v[i] = -m.velocity_v[i];
+    } else if (v >= kThinkiverse.bottom) {
+        v               = kThinkiverse.bottom - 1;
+        m.velocity_v[i] = -m.velocity_v[i];
     }
 }
 
@@ -319,7 +555,7 @@ static void move_vector(SpaceObject* o) {
         if (vector.toObject.get()) {
             auto target = vector.toObject;
             if (target->active && (target->id == vector.toObjectID)) {
-                o->location = vector.objectLocation = target->location;
+                o->location = vector.objectLocation = motion.location(*target);
             } else {
                 o->active = kObjectToBeFreed;
             }
@@ -328,7 +564,8 @@ static void move_vector(SpaceObject* o) {
         if (vector.fromObject.get()) {
             auto target = vector.fromObject;
             if (target->active && (target->id == vector.fromObjectID)) {
-                vector.lastGlobalLocation = vector.lastApparentLocation = target->location;
+                vector.lastGlobalLocation = vector.lastApparentLocation =
+                        motion.location(*target);
             } else {
                 o->active = kObjectToBeFreed;
             }
@@ -337,11 +574,12 @@ static void move_vector(SpaceObject* o) {
         if (vector.fromObject.get()) {
             auto target = vector.fromObject;
             if (target->active && (target->id == vector.fromObjectID)) {
-                vector.lastGlobalLocation = vector.lastApparentLocation = target->location;
-                o->location.h                                           = vector.objectLocation.h =
-                        target->location.h + vector.toRelativeCoord.h;
+                Point target_location     = motion.location(*target);
+                vector.lastGlobalLocation = vector.lastApparentLocation = target_location;
+                o->location.h = vector.objectLocation.h =
+                        target_location.h + vector.toRelativeCoord.h;
                 o->location.v = vector.objectLocation.v =
-                        target->location.v + vector.toRelativeCoord.v;
+                        target_location.v + vector.toRelativeCoord.v;
             } else {
                 o->active = kObjectToBeFreed;
             }
@@ -401,23 +639,39 @@ void MoveSpaceObjects(const ticks unitsToDo) {
         return;
     }
 
+    motion.load();
     for (ticks jl = ticks(0); jl < unitsToDo; jl++) {
-        SpaceObject* o = nullptr;
-        for (Handle<SpaceObject> o_handle = g.root; (o = o_handle.get());
-             o_handle                     = o->nextObject) {
-            if (o->active != kObjectInUse) {
+        // Accelerating and carrying only read each object's own state, so they can be done for
+        // all objects up front. Moving has to wait for the second pass, because vectors read
+        // other objects' locations, and must see them before or after moving, as they would if
+        // each object were moved in turn.
+        for (int32_t i = 0; i < motion.object.size(); ++i) {
+            if (motion.moving[i]) {
+                accelerate_object(motion, i);
+            }
+        }
+        motion.carry();
+
+        for (int32_t i = 0; i < motion.object.size(); ++i) {
+            if (!motion.moving[i]) {
                 continue;
             }
 
-            move_object(o);
-            bounce_object(o);
-            if (o->attributes & kIsSelfAnimated) {
+            SpaceObject* o = motion.object[i];
+            move_object(motion, i);
+            bounce_object(motion, i);
+            if (motion.attributes[i] & kIsSelfAnimated) {
                 animate_object(o);
-            } else if (o->attributes & kIsVector) {
+            } else if (motion.attributes[i] & kIsVector) {
+                o->location = {motion.location_h[i], motion.location_v[i]};
                 move_vector(o);
+                motion.location_h[i] = o->location.h;
+                motion.location_v[i] = o->location.v;
             }
+            motion.moving[i] = (o->active == kObjectInUse);
         }
     }
+    motion.store();
 
     if (g.ship.get() && g.ship->active) {
         Size scale{((play_screen().width() / 2) * SCALE_SCALE) / gAbsoluteScale,
@@ -486,18 +740,16 @@ static void activate_object(const Handle<SpaceObject>& o) {
     }
 }
 
-static void calc_misc(
-        Handle<SpaceObject> near_objects[PROXIMITY_GRID_AREA],
-        Handle<SpaceObject> far_objects[PROXIMITY_GRID_AREA]) {
+static void calc_misc() {
     // set up player info so we can find closest ship (for scaling)
     uint64_t farthestDist = 0;
     uint64_t closestDist  = 0x7fffffffffffffffull;
     g.closest = g.farthest = Handle<SpaceObject>(0);
 
     // reset the collision grid
-    for (int32_t i = 0; i < PROXIMITY_GRID_AREA; i++) {
-        near_objects[i] = far_objects[i] = SpaceObject::none();
-    }
+    near_index.clear();
+    far_index.clear();
+    Handle<SpaceObject> far_objects[PROXIMITY_GRID_AREA];
 
     SpaceObject* o = nullptr;
     for (auto o_handle = g.root; (o = o_handle.get()); o_handle = o->nextObject) {
@@ -552,23 +804,24 @@ static void calc_misc(
 
             const auto& loc = o->location;
             {
-                auto* near_object = &near_objects[proximity_index(
-                        (loc.h / SUBSECTOR) & PROXIMITY_GRID_MASK,
-                        (loc.v / SUBSECTOR) & PROXIMITY_GRID_MASK)];
-                o->nextNearObject = *near_object;
-                *near_object      = o_handle;
-
                 o->collisionGrid = {loc.h / SECTOR_MEDIUM, loc.v / SECTOR_MEDIUM};
+                near_index.add(
+                        o_handle, o->collisionGrid,
+                        proximity_index(
+                                (loc.h / SUBSECTOR) & PROXIMITY_GRID_MASK,
+                                (loc.v / SUBSECTOR) & PROXIMITY_GRID_MASK));
             }
 
             {
-                auto* far_object = &far_objects[proximity_index(
+                o->distanceGrid = {loc.h / SECTOR_HUGE, loc.v / SECTOR_HUGE};
+                int32_t index   = proximity_index(
                         (loc.h / SECTOR_MEDIUM) & PROXIMITY_GRID_MASK,
-                        (loc.v / SECTOR_MEDIUM) & PROXIMITY_GRID_MASK)];
-                o->nextFarObject = *far_object;
-                *far_object      = o_handle;
+                        (loc.v / SECTOR_MEDIUM) & PROXIMITY_GRID_MASK);
+                far_index.add(o_handle, o->distanceGrid, index);
 
-                o->distanceGrid = {loc.h / SECTOR_HUGE, loc.v / SECTOR_HUGE};
+                // Admiral::think() still walks nextFarObject, so keep that list too.
+                o->nextFarObject   = far_objects[index];
+                far_objects[index] = o_handle;
             }
 
             if (!(o->attributes & kIsDestination)) {
@@ -582,6 +835,9 @@ static void calc_misc(
             }
         }
     }
+
+    near_index.build();
+    far_index.build();
 }
 
 // Collision uses inclusive rect bounds for historical reasons.
@@ -708,54 +964,37 @@ static bool can_hit(const SpaceObject& a, const SpaceObject& b) {
 }
 
 // Call HitObject() and CorrectPhysicalSpace() for all colliding pairs of objects.
-static void calc_impacts(Handle<SpaceObject> near_objects[PROXIMITY_GRID_AREA]) {
-    for (int32_t i = 0; i < PROXIMITY_GRID_AREA; i++) {
-        const auto*  cells = kAdjacentCells.at[i];
-        SpaceObject* a     = nullptr;
-        for (auto a_handle = near_objects[i]; (a = a_handle.get()); a_handle = a->nextNearObject) {
-            for (int32_t k = 0; k < AdjacentCells::size; k++) {
-                Handle<SpaceObject> b_handle = a->nextNearObject;
-                Point               super    = a->collisionGrid;
-                if (k > 0) {
-                    const auto& adj = cells[k];
-                    b_handle        = near_objects[adj.index_offset];
-                    super.offset(adj.super_offset.h, adj.super_offset.v);
-                }
-
-                SpaceObject* b = nullptr;
-                for (; (b = b_handle.get()); b_handle = b->nextNearObject) {
-                    if ((!can_hit(*a, *b) &&
-                         !can_hit(*b, *a)) ||           // neither object can hit the other
-                        (b->collisionGrid != super) ||  // not near enough
-                        (a->owner == b->owner)) {       // same owner
-                        continue;
-                    }
-
-                    if (a->attributes & b->attributes & kIsVector) {
-                        // no reason vectors can't intersect, but the
-                        // code we have now won't handle it.
-                        continue;
-                    } else if (a->attributes & kIsVector) {
-                        if (vector_intersects(*a, *b)) {
-                            HitObject(b_handle, a_handle);
-                        }
-                        continue;
-                    } else if (b->attributes & kIsVector) {
-                        if (vector_intersects(*b, *a)) {
-                            HitObject(a_handle, b_handle);
-                        }
-                        continue;
-                    }
+static void calc_impacts() {
+    near_index.for_each_pair([](Handle<SpaceObject> a_handle, Handle<SpaceObject> b_handle, int) {
+        SpaceObject* a = a_handle.get();
+        SpaceObject* b = b_handle.get();
+        if ((!can_hit(*a, *b) && !can_hit(*b, *a)) ||  // neither object can hit the other
+            (a->owner == b->owner)) {                   // same owner
+            return;
+        }
 
-                    if (inclusive_intersect(a->absoluteBounds, b->absoluteBounds)) {
-                        HitObject(a_handle, b_handle);
-                        HitObject(b_handle, a_handle);
-                        correct_physical_space(a, b);
-                    }
-                }
+        if (a->attributes & b->attributes & kIsVector) {
+            // no reason vectors can't intersect, but the
+            // code we have now won't handle it.
+            return;
+        } else if (a->attributes & kIsVector) {
+            if (vector_intersects(*a, *b)) {
+                HitObject(b_handle, a_handle);
+            }
+            return;
+        } else if (b->attributes & kIsVector) {
+            if (vector_intersects(*b, *a)) {
+                HitObject(a_handle, b_handle);
             }
+            return;
         }
-    }
+
+        if (inclusive_intersect(a->absoluteBounds, b->absoluteBounds)) {
+            HitObject(a_handle, b_handle);
+            HitObject(b_handle, a_handle);
+            correct_physical_space(a, b);
+        }
+    });
 }
 
 // Sets the following properties on objects:
@@ -764,84 +1003,63 @@ static void calc_impacts(Handle<SpaceObject> near_objects[PROXIMITY_GRID_AREA])
 //   * localFriendStrength
 //   * localFoeStrength
 // Also sets seenByPlayerFlags and kIsHidden based on object proximity.
-static void calc_locality(Handle<SpaceObject> far_objects[PROXIMITY_GRID_AREA]) {
-    for (int32_t i = 0; i < PROXIMITY_GRID_AREA; i++) {
-        const auto*  cells = kAdjacentCells.at[i];
-        SpaceObject* a     = nullptr;
-        for (auto a_handle = far_objects[i]; (a = a_handle.get()); a_handle = a->nextFarObject) {
-            for (int32_t k = 0; k < AdjacentCells::size; k++) {
-                Handle<SpaceObject> b_handle = a->nextFarObject;
-                Point               super    = a->distanceGrid;
-                if (k > 0) {
-                    const auto& adj = cells[k];
-                    b_handle        = far_objects[adj.index_offset];
-                    super.offset(adj.super_offset.h, adj.super_offset.v);
+static void calc_locality() {
+    far_index.for_each_pair([](Handle<SpaceObject> a_handle, Handle<SpaceObject> b_handle, int k) {
+        SpaceObject* a = a_handle.get();
+        SpaceObject* b = b_handle.get();
+        if ((b->owner != a->owner) &&
+            ((b->attributes & kCanThink) || (b->attributes & kRemoteOrHuman) ||
+             (b->attributes & kHated)) &&
+            ((a->attributes & kCanThink) || (a->attributes & kRemoteOrHuman) ||
+             (a->attributes & kHated))) {
+            uint32_t x_dist = ABS<int>(b->location.h - a->location.h);
+            uint32_t y_dist = ABS<int>(b->location.v - a->location.v);
+            uint32_t dist;
+            if ((x_dist > kMaximumRelevantDistance) || (y_dist > kMaximumRelevantDistance)) {
+                dist = kMaximumRelevantDistanceSquared;
+            } else {
+                dist = (y_dist * y_dist) + (x_dist * x_dist);
+            }
+
+            if (dist < kMaximumRelevantDistanceSquared) {
+                a->seenByPlayerFlags |= b->myPlayerFlag;
+                b->seenByPlayerFlags |= a->myPlayerFlag;
+
+                if (b->attributes & kHideEffect) {
+                    a->runTimeFlags |= kIsHidden;
                 }
 
-                SpaceObject* b = nullptr;
-                for (; (b = b_handle.get()); b_handle = b->nextFarObject) {
-                    if (b->distanceGrid != super) {
-                        continue;
-                    }
-                    if ((b->owner != a->owner) &&
-                        ((b->attributes & kCanThink) || (b->attributes & kRemoteOrHuman) ||
-                         (b->attributes & kHated)) &&
-                        ((a->attributes & kCanThink) || (a->attributes & kRemoteOrHuman) ||
-                         (a->attributes & kHated))) {
-                        uint32_t x_dist = ABS<int>(b->location.h - a->location.h);
-                        uint32_t y_dist = ABS<int>(b->location.v - a->location.v);
-                        uint32_t dist;
-                        if ((x_dist > kMaximumRelevantDistance) ||
-                            (y_dist > kMaximumRelevantDistance)) {
-                            dist = kMaximumRelevantDistanceSquared;
-                        } else {
-                            dist = (y_dist * y_dist) + (x_dist * x_dist);
-                        }
-
-                        if (dist < kMaximumRelevantDistanceSquared) {
-                            a->seenByPlayerFlags |= b->myPlayerFlag;
-                            b->seenByPlayerFlags |= a->myPlayerFlag;
-
-                            if (b->attributes & kHideEffect) {
-                                a->runTimeFlags |= kIsHidden;
-                            }
-
-                            if (a->attributes & kHideEffect) {
-                                b->runTimeFlags |= kIsHidden;
-                            }
-                        }
-
-                        if (a->engages(*b)) {
-                            if ((dist < a->closestDistance) &&
-                                (b->attributes & kPotentialTarget)) {
-                                a->closestDistance = dist;
-                                a->closestObject   = b_handle;
-                            }
-                        }
-
-                        if (b->engages(*a)) {
-                            if ((dist < b->closestDistance) &&
-                                (a->attributes & kPotentialTarget)) {
-                                b->closestDistance = dist;
-                                b->closestObject   = a_handle;
-                            }
-                        }
-
-                        b->localFoeStrength += a->localFriendStrength;
-                        b->localFriendStrength += a->localFoeStrength;
-                    } else if (k == 0) {
-                        if (a->owner != b->owner) {
-                            b->localFoeStrength += a->localFriendStrength;
-                            b->localFriendStrength += a->localFoeStrength;
-                        } else {
-                            b->localFoeStrength += a->localFoeStrength;
-                            b->localFriendStrength += a->localFriendStrength;
-                        }
-                    }
+                if (a->attributes & kHideEffect) {
+                    b->runTimeFlags |= kIsHidden;
+                }
+            }
+
+            if (a->engages(*b)) {
+                if ((dist < a->closestDistance) && (b->attributes & kPotentialTarget)) {
+                    a->closestDistance = dist;
+                    a->closestObject   = b_handle;
+                }
+            }
+
+            if (b->engages(*a)) {
+                if ((dist < b->closestDistance) && (a->attributes & kPotentialTarget)) {
+                    b->closestDistance = dist;
+                    b->closestObject   = a_handle;
                 }
             }
+
+            b->localFoeStrength += a->localFriendStrength;
+            b->localFriendStrength += a->localFoeStrength;
+        } else if (k == 0) {
+            if (a->owner != b->owner) {
+                b->localFoeStrength += a->localFriendStrength;
+                b->localFriendStrength += a->localFoeStrength;
+            } else {
+                b->localFoeStrength += a->localFoeStrength;
+                b->localFriendStrength += a->localFriendStrength;
+            }
         }
-    }
+    });
 }
 
 static void calc_visibility() {
@@ -880,13 +1098,10 @@ static void update_last_vector_locations() {
 }
 
 void CollideSpaceObjects() {
-    Handle<SpaceObject> near_objects[PROXIMITY_GRID_AREA];
-    Handle<SpaceObject> far_objects[PROXIMITY_GRID_AREA];
-
-    calc_misc(near_objects, far_objects);
+    calc_misc();
     calc_bounds();
-    calc_impacts(near_objects);
-    calc_locality(far_objects);
+    calc_impacts();
+    calc_locality();
     calc_visibility();
     update_last_vector_locations();
 }
@@ -908,27 +1123,10 @@ static void adjust_velocity(SpaceObject* o, int16_t angle, Fixed totalMass, Fixe
 }
 
 static void push(SpaceObject* o) {
-    o->motionFraction.h += o->velocity.h;
-    o->motionFraction.v += o->velocity.v;
-
-    int32_t h;
-    if (o->motionFraction.h >= Fixed::zero()) {
-        h = more_evil_fixed_to_long(o->motionFraction.h + Fixed::from_float(0.5));
-    } else {
-        h = more_evil_fixed_to_long(o->motionFraction.h - Fixed::from_float(0.5)) + 1;
-    }
+    int32_t h = carry_fraction(o->velocity.h, &o->motionFraction.h);
+    int32_t v = carry_fraction(o->velocity.v, &o->motionFraction.v);
     o->location.h -= h;
-    o->motionFraction.h -= Fixed::from_long(h);
-
-    int32_t v;
-    if (o->motionFraction.v >= Fixed::zero()) {
-        v = more_evil_fixed_to_long(o->motionFraction.v + Fixed::from_float(0.5));
-    } else {
-        v = more_evil_fixed_to_long(o->motionFraction.v - Fixed::from_float(0.5)) + 1;
-    }
     o->location.v -= v;
-    o->motionFraction.v -= Fixed::from_long(v);
-
     o->absoluteBounds.offset(-h, -v);
 }
 
@@ -18,6 +18,7 @@
 
 #include "game/non-player-ship.hpp"
 
+#include <algorithm>
 #include <pn/output>
 
 #include "config/keys.hpp"
@@ -34,6 +35,8 @@
 #include "game/space-object.hpp"
 #include "game/starfield.hpp"
 #include "game/sys.hpp"
+#include "game/target-index.hpp"
+#include "lang/defines.hpp"
 #include "math/macros.hpp"
 #include "math/random.hpp"
 #include "math/rotation.hpp"
@@ -59,6 +62,9 @@ const int32_t kWeaponRatio        = 2;
 const int32_t kEnergyChunk        = kHealthRatio + (kWeaponRatio * 3);
 const int32_t kWarpInEnergyFactor = 3;
 
+const uint32_t kCoastThreatDistance = kEngageRange * 4;  // threats this close end coasting
+const int32_t  kMaxCoastInterval    = 8;  // most major ticks between thinks of a coasting object
+
 static const ticks    kCollideFlashDuration = ticks{3};
 static const RgbColor kCollideFlashColor    = rgba(255, 255, 255, 127);
 
@@ -182,6 +188,36 @@ static uint8_t get_tiny_shade(const SpaceObject& o) {
     }
 }
 
+// A fixed, well-mixed phase for each object, so that objects which think at the same interval
+// don't all think on the same major tick.
+static uint32_t think_phase(int32_t id) { return (static_cast<uint32_t>(id) * 0x9e3779b1u) >> 16; }
+
+// How many major ticks `o` may go between full thinks. Only objects of admirals using the planner
+// coast at all; objects of other admirals, and neutral objects, think every major tick as they
+// always have. Of the rest, objects that might have to fight or flee, and objects that are doing
+// something other than travelling, think every major tick. Travelling objects think more often
+// the sooner they will arrive at their current speed.
+static int32_t think_interval(const SpaceObject& o) {
+    if (!o.owner.get() || !(o.owner->attributes() & kAIsPlanner) ||
+        (o.attributes & (kRemoteOrHuman | kIsGuided)) || (o.presenceState != kNormalPresence) ||
+        o.targetObject.get() || (o.closestDistance < kCoastThreatDistance)) {
+        return 1;
+    }
+
+    int32_t speed = std::max(ABS(o.velocity.h.val()), ABS(o.velocity.v.val()));
+    if (speed == 0) {
+        return kMaxCoastInterval;
+    }
+    int64_t distance = lsqrt(o.lastTargetDistance);
+    int64_t arrival  = (distance * Fixed::from_long(1).val()) / (speed * kMajorTick.count());
+    return std::max<int64_t>(1, std::min<int64_t>(kMaxCoastInterval, arrival / 4));
+}
+
+// Whether `o` should think fully on this major tick, or coast on its last decision.
+static bool should_think(const SpaceObject& o, int64_t major_tick) {
+    return ((major_tick + think_phase(o.id)) % think_interval(o)) == 0;
+}
+
 void NonplayerShipThink() {
     uint8_t friendSick, foeSick, neutralSick;
     switch ((std::chrono::time_point_cast<ticks>(g.time).time_since_epoch().count() / 9) % 4) {
@@ -194,6 +230,10 @@ void NonplayerShipThink() {
             break;
     }
 
+    const int64_t major_tick =
+            std::chrono::time_point_cast<ticks>(g.time).time_since_epoch().count() /
+            kMajorTick.count();
+
     g.sync = g.random.seed;
     for (int32_t count = 0; count < kMaxPlayerNum; count++) {
         Handle<Admiral>(count)->shipsLeft() = 0;
@@ -232,7 +272,6 @@ void NonplayerShipThink() {
 
         // get the object's base object
         auto baseObject = o->base;
-        o->targetAngle = o->directionGoal = o->direction;
 
         // incremenent its admiral's # of ships
         if (o->owner.get()) {
@@ -240,20 +279,26 @@ void NonplayerShipThink() {
         }
 
         uint32_t keysDown;
-        switch (o->presenceState) {
-            case kNormalPresence:
-                keysDown = ThinkObjectNormalPresence(o_handle, baseObject);
-                break;
+        if (!should_think(*o, major_tick)) {
+            // coast: keep heading for the last direction goal, and keep thrusting or braking
+            keysDown = o->keysDown & (kUpKey | kDownKey);
+        } else {
+            o->targetAngle = o->directionGoal = o->direction;
+            switch (o->presenceState) {
+                case kNormalPresence:
+                    keysDown = ThinkObjectNormalPresence(o_handle, baseObject);
+                    break;
 
-            case kWarpingPresence: keysDown = ThinkObjectWarpingPresence(o_handle); break;
+                case kWarpingPresence: keysDown = ThinkObjectWarpingPresence(o_handle); break;
 
-            case kWarpInPresence: keysDown = ThinkObjectWarpInPresence(o_handle); break;
+                case kWarpInPresence: keysDown = ThinkObjectWarpInPresence(o_handle); break;
 
-            case kWarpOutPresence:
-                keysDown = ThinkObjectWarpOutPresence(o_handle, baseObject);
-                break;
+                case kWarpOutPresence:
+                    keysDown = ThinkObjectWarpOutPresence(o_handle, baseObject);
+                    break;
 
-            case kLandingPresence: keysDown = ThinkObjectLandingPresence(o_handle); break;
+                case kLandingPresence: keysDown = ThinkObjectLandingPresence(o_handle); break;
+            }
         }
 
         if (!(o->attributes & kRemoteOrHuman) || (o->attributes & kOnAutoPilot)) {
@@ -1536,104 +1581,61 @@ static bool allegiance_is(
     }
 }
 
+// The index is built on the first selection after it goes stale. It goes stale once per major
+// tick, since objects have moved, and whenever objects are added or moved by actions. Most
+// major ticks have no selection at all, so most never build it.
+static ANTARES_GLOBAL TargetIndex target_index;
+static ANTARES_GLOBAL std::vector<TargetIndex::Entry> target_entries;
+static ANTARES_GLOBAL bool                            target_index_stale = true;
+
+static void build_manual_select_index() {
+    target_entries.clear();
+    SpaceObject* o;
+    for (auto o_handle = g.root; (o = o_handle.get()); o_handle = o->nextObject) {
+        if (o->active) {
+            target_entries.push_back({o_handle.number(), o->location});
+        }
+    }
+    target_index.build(target_entries);
+    target_index_stale = false;
+}
+
+void InvalidateManualSelectIndex() { target_index_stale = true; }
+
 // GetManualSelectObject:
 //  For the human player selecting a ship.  If friend or foe = 0, will get any ship.  If it's
 //  positive, will get only friendly ships.  If it's negative, only unfriendly ships.
+//
+//  Cycling starts with currentShip, if it's still in use, and goes around g.root from there;
+//  TargetIndex picks whatever walking that loop and testing each object would.
 
 Handle<SpaceObject> GetManualSelectObject(
         Handle<SpaceObject> sourceObject, int32_t direction, uint32_t inclusiveAttributes,
         uint32_t exclusiveAttributes, const uint64_t* fartherThan, Handle<SpaceObject> currentShip,
         Allegiance allegiance) {
-    const uint32_t myOwnerFlag = 1 << sourceObject->owner.number();
-
-    uint64_t wideClosestDistance = 0x3fffffff3fffffffull;
-    uint64_t wideFartherDistance = 0x3fffffff3fffffffull;
-
-    // Here's what you've got to do next:
-    // start with the currentShip
-    // try to get any ship but the current ship
-    // stop trying when we've made a full circle (we're back on currentShip)
-
-    Handle<SpaceObject> anObject;
-    auto                whichShip = currentShip;
-    auto                startShip = currentShip;
-    if (whichShip.get()) {
-        anObject = startShip;
-        if (anObject->active != kObjectInUse) {  // if it's not in the loop
-            anObject  = g.root;
-            startShip = whichShip = g.root;
-        }
-    } else {
-        anObject  = g.root;
-        startShip = whichShip = g.root;
+    if (target_index_stale) {
+        build_manual_select_index();
     }
 
-    Handle<SpaceObject> nextShipOut, closestShip;
-    do {
-        if (anObject->active && (anObject != sourceObject) &&
-            (anObject->seenByPlayerFlags & myOwnerFlag) &&
-            (anObject->attributes & inclusiveAttributes) &&
-            !(anObject->attributes & exclusiveAttributes) &&
-            allegiance_is(allegiance, sourceObject->owner, anObject)) {
-            uint32_t xdiff = ABS<int>(sourceObject->location.h - anObject->location.h);
-            uint32_t ydiff = ABS<int>(sourceObject->location.v - anObject->location.v);
-
-            uint64_t thisWideDistance;
-            if ((xdiff > kMaximumRelevantDistance) || (ydiff > kMaximumRelevantDistance)) {
-                thisWideDistance =
-                        MyWideMul<uint64_t>(xdiff, xdiff) + MyWideMul<uint64_t>(ydiff, ydiff);
-            } else {
-                thisWideDistance = ydiff * ydiff + xdiff * xdiff;
-            }
-
-            // Nearer than the nearest candidate so far.
-            bool is_closest = thisWideDistance < wideClosestDistance;
-
-            // Farther than *fartherThan, but nearer than any other candidate so far.
-            bool is_closest_far_object =
-                    (thisWideDistance > *fartherThan) && (wideFartherDistance > thisWideDistance);
-
-            if (is_closest || is_closest_far_object) {
-                int32_t hdif = sourceObject->location.h - anObject->location.h;
-                int32_t vdif = sourceObject->location.v - anObject->location.v;
-                while ((ABS(hdif) > kMaximumAngleDistance) ||
-                       (ABS(vdif) > kMaximumAngleDistance)) {
-                    hdif >>= 1;
-                    vdif >>= 1;
-                }
-
-                int16_t angle = AngleFromSlope(MyFixRatio(hdif, vdif));
-
-                if (hdif > 0) {
-                    mAddAngle(angle, 180);
-                } else if ((hdif == 0) && (vdif > 0)) {
-                    angle = 0;
-                }
-
-                if (ABS(mAngleDifference(angle, direction)) < 30) {
-                    if (is_closest) {
-                        closestShip         = whichShip;
-                        wideClosestDistance = thisWideDistance;
-                    }
-
-                    if (is_closest_far_object) {
-                        nextShipOut         = whichShip;
-                        wideFartherDistance = thisWideDistance;
-                    }
-                }
-            }
-        }
-        whichShip = anObject = anObject->nextObject;
-        if (!anObject.get()) {
-            whichShip = anObject = g.root;
-        }
-    } while (whichShip != startShip);
-
-    if ((!nextShipOut.get() && closestShip.get()) || (nextShipOut == currentShip)) {
-        nextShipOut = closestShip;
+    TargetIndex::Query q;
+    q.origin       = sourceObject->location;
+    q.direction    = direction;
+    q.farther_than = *fartherThan;
+    q.start        = -1;
+    q.current      = currentShip.number();
+    if (currentShip.get() && (currentShip->active == kObjectInUse)) {
+        q.start = currentShip.number();
     }
 
-    return nextShipOut;
+    const uint32_t myOwnerFlag = 1 << sourceObject->owner.number();
+
+    auto eligible = [&](int32_t number) {
+        Handle<SpaceObject> o(number);
+        return o->active && (o != sourceObject) && (o->seenByPlayerFlags & myOwnerFlag) &&
+               (o->attributes & inclusiveAttributes) && !(o->attributes & exclusiveAttributes) &&
+               allegiance_is(allegiance, sourceObject->owner, o);
+    };
+    return Handle<SpaceObject>(target_index.select(q, eligible));
 }
 
 Handle<SpaceObject> GetSpritePointSelectObject(
@@ -40,6 +40,7 @@
 #include "game/messages.hpp"
 #include "game/minicomputer.hpp"
 #include "game/non-player-ship.hpp"
+#include "game/snapshot.hpp"
 #include "game/space-object.hpp"
 #include "game/starfield.hpp"
 #include "game/sys.hpp"
@@ -145,6 +146,20 @@ PlayerShip::PlayerShip()
           _control_active(false),
           _control_direction(0) {}
 
+void archive(StateArchive& a, PlayerShip& ship) {
+    a(ship.gTheseKeys)(ship._gamepad_keys)(ship._gamepad_state);
+    a(ship._control_active)(ship._control_direction);
+    for (int i = 0; i < 256; ++i) {
+        bool down = ship._keys.get(static_cast<Key>(i));
+        a(down);
+        ship._keys.set(static_cast<Key>(i), down);
+    }
+    a(gDestKeyState)(gDestKeyTime)(gHotKeyState)(gHotKeyTime)(gPreviousZoomMode);
+    if (a.is_loading()) {
+        ship._player_events.clear();
+    }
+}
+
 static sfz::optional<KeyNum> key_num(Key key) {
     for (int i = 0; i < kKeyExtendedControlNum; ++i) {
         if (key == sys.prefs->key(i)) {
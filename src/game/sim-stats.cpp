@@ -0,0 +1,43 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/sim-stats.hpp"
+
+#include <algorithm>
+
+#include "game/action.hpp"
+#include "game/globals.hpp"
+
+namespace antares {
+
+void SimStats::Pool::sample(int32_t used, sfz::optional<int32_t> capacity) {
+    this->capacity = capacity;
+    peak           = std::max(peak, used);
+}
+
+void SimStats::sample() {
+    ++major_ticks;
+    objects.sample(g.object_slots.used(), g.object_slots.capacity());
+
+    sprites.sample(g.sprite_slots.used(), g.sprite_slots.capacity());
+    labels.sample(g.label_slots.used(), g.label_slots.capacity());
+    vectors.sample(g.vector_slots.used(), g.vector_slots.capacity());
+
+    actions.sample(action_queue_used(), sfz::nullopt);
+}
+
+}  // namespace antares
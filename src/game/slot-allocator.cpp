@@ -0,0 +1,103 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/slot-allocator.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace antares {
+
+static int lowest_bit(uint64_t word) { return __builtin_ctzll(word); }
+
+void SlotAllocator::reset(int32_t capacity) {
+    if (capacity < 0) {
+        throw std::runtime_error("negative slot capacity");
+    }
+    _capacity = capacity;
+    _used     = 0;
+    _free.assign((capacity + 63) / 64, ~uint64_t{0});
+    if (capacity % 64) {
+        _free.back() = (uint64_t{1} << (capacity % 64)) - 1;
+    }
+    _summary.assign((_free.size() + 63) / 64, ~uint64_t{0});
+    if (_free.size() % 64) {
+        _summary.back() = (uint64_t{1} << (_free.size() % 64)) - 1;
+    }
+}
+
+int32_t SlotAllocator::allocate() {
+    for (size_t i = 0; i < _summary.size(); ++i) {
+        if (_summary[i]) {
+            size_t  word = (i * 64) + lowest_bit(_summary[i]);
+            int32_t slot = (word * 64) + lowest_bit(_free[word]);
+            set_used(slot, true);
+            return slot;
+        }
+    }
+    return -1;
+}
+
+void SlotAllocator::release(int32_t slot) { set_used(slot, false); }
+
+void SlotAllocator::set_used(int32_t slot, bool used) {
+    if ((slot < 0) || (slot >= _capacity)) {
+        throw std::runtime_error("slot out of range");
+    } else if (is_used(slot) == used) {
+        return;
+    }
+
+    uint64_t& word = _free[slot / 64];
+    uint64_t  bit  = uint64_t{1} << (slot % 64);
+    if (used) {
+        word &= ~bit;
+        ++_used;
+    } else {
+        word |= bit;
+        --_used;
+    }
+
+    uint64_t summary_bit = uint64_t{1} << ((slot / 64) % 64);
+    if (word) {
+        _summary[slot / 4096] |= summary_bit;
+    } else {
+        _summary[slot / 4096] &= ~summary_bit;
+    }
+}
+
+bool SlotAllocator::is_used(int32_t slot) const {
+    return !(_free[slot / 64] & (uint64_t{1} << (slot % 64)));
+}
+
+int32_t SlotAllocator::next_used(int32_t slot) const {
+    if (slot >= _capacity) {
+        return _capacity;
+    }
+    // Bits past the capacity are clear in the last word of _free, so they read as used here;
+    // they can only be found when no real slot is, and are clamped to the capacity.
+    size_t   word = slot / 64;
+    uint64_t used = ~_free[word] & (~uint64_t{0} << (slot % 64));
+    while (!used) {
+        if (++word == _free.size()) {
+            return _capacity;
+        }
+        used = ~_free[word];
+    }
+    return std::min<int32_t>(_capacity, (word * 64) + lowest_bit(used));
+}
+
+}  // namespace antares
@@ -0,0 +1,139 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/slot-allocator.hpp"
+
+#include <gmock/gmock.h>
+
+using testing::Eq;
+
+namespace antares {
+namespace {
+
+using SlotAllocatorTest = testing::Test;
+
+TEST_F(SlotAllocatorTest, Empty) {
+    SlotAllocator slots;
+    slots.reset(0);
+    EXPECT_THAT(slots.allocate(), Eq(-1));
+}
+
+TEST_F(SlotAllocatorTest, LowestFirst) {
+    SlotAllocator slots;
+    slots.reset(5);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_THAT(slots.allocate(), Eq(i));
+    }
+    EXPECT_THAT(slots.allocate(), Eq(-1));
+    EXPECT_THAT(slots.used(), Eq(5));
+
+    slots.release(3);
+    slots.release(1);
+    EXPECT_THAT(slots.used(), Eq(3));
+    EXPECT_THAT(slots.allocate(), Eq(1));
+    EXPECT_THAT(slots.allocate(), Eq(3));
+    EXPECT_THAT(slots.allocate(), Eq(-1));
+}
+
+// Compares against a linear scan for the first free slot, across several words of the bitmap
+// and several summary words.
+TEST_F(SlotAllocatorTest, MatchesLinearScan) {
+    const int32_t     capacity = 10000;
+    SlotAllocator     slots;
+    std::vector<bool> used(capacity, false);
+    slots.reset(capacity);
+
+    uint32_t seed = 1;
+    for (int i = 0; i < 100000; ++i) {
+        seed = (seed * 1103515245) + 12345;
+        if ((seed >> 16) % 2) {
+            int32_t expected = -1;
+            for (int32_t j = 0; j < capacity; ++j) {
+                if (!used[j]) {
+                    expected = j;
+                    break;
+                }
+            }
+            ASSERT_THAT(slots.allocate(), Eq(expected));
+            if (expected >= 0) {
+                used[expected] = true;
+            }
+        } else {
+            int32_t slot = (seed >> 8) % capacity;
+            slots.release(slot);
+            used[slot] = false;
+        }
+    }
+
+    int32_t count = 0;
+    for (int32_t j = 0; j < capacity; ++j) {
+        EXPECT_THAT(slots.is_used(j), Eq(used[j]));
+        count += used[j];
+    }
+    EXPECT_THAT(slots.used(), Eq(count));
+}
+
+TEST_F(SlotAllocatorTest, NextUsed) {
+    SlotAllocator slots;
+    slots.reset(130);
+    EXPECT_THAT(slots.next_used(0), Eq(130));
+    for (int32_t slot : {3, 64, 129}) {
+        slots.set_used(slot, true);
+    }
+    EXPECT_THAT(slots.next_used(0), Eq(3));
+    EXPECT_THAT(slots.next_used(3), Eq(3));
+    EXPECT_THAT(slots.next_used(4), Eq(64));
+    EXPECT_THAT(slots.next_used(65), Eq(129));
+    EXPECT_THAT(slots.next_used(130), Eq(130));
+
+    slots.release(129);
+    EXPECT_THAT(slots.next_used(65), Eq(130));
+}
+
+// Iterating over the used slots visits the same slots, in the same order, as a scan over every
+// slot that skips the free ones, even as slots are allocated and released along the way.
+TEST_F(SlotAllocatorTest, UsedHandleListMatchesScan) {
+    struct Entry {};
+    SlotAllocator slots;
+    slots.reset(200);
+    for (int32_t slot = 0; slot < 200; slot += 3) {
+        slots.set_used(slot, true);
+    }
+
+    std::vector<int32_t> expected;
+    for (int32_t slot = 0; slot < 200; ++slot) {
+        if (slots.is_used(slot)) {
+            expected.push_back(slot);
+            if (slot == 60) {
+                slots.release(63);
+            }
+        }
+    }
+    slots.set_used(63, true);
+
+    std::vector<int32_t> actual;
+    for (auto h : UsedHandleList<Entry>(slots)) {
+        actual.push_back(h.number());
+        if (h.number() == 60) {
+            slots.release(63);
+        }
+    }
+    EXPECT_THAT(actual, Eq(expected));
+}
+
+}  // namespace
+}  // namespace antares
@@ -0,0 +1,179 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/snapshot.hpp"
+
+#include <string.h>
+
+#include "drawing/sprite-handling.hpp"
+#include "game/action.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/minicomputer.hpp"
+#include "game/motion.hpp"
+#include "game/player-ship.hpp"
+#include "game/space-object.hpp"
+#include "game/vector.hpp"
+
+namespace antares {
+
+StateArchive& StateArchive::operator()(pn::string& s) {
+    size_t size = s.size();
+    (*this)(size);
+    if (is_loading()) {
+        std::vector<char> chars(size);
+        bytes(chars.data(), size);
+        s = pn::string_view{chars.data(), static_cast<int>(size)}.copy();
+    } else {
+        bytes(const_cast<char*>(s.data()), size);
+    }
+    return *this;
+}
+
+StateArchive& StateArchive::operator()(std::vector<bool>& v) {
+    size_t size = v.size();
+    (*this)(size);
+    v.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        bool b = v[i];
+        (*this)(b);
+        v[i] = b;
+    }
+    return *this;
+}
+
+void StateArchive::bytes(void* data, size_t size) {
+    if (is_loading()) {
+        if (_pos + size > _in->size()) {
+            throw std::runtime_error("snapshot truncated");
+        }
+        memcpy(data, _in->data() + _pos, size);
+    } else {
+        auto p = static_cast<const uint8_t*>(data);
+        _out->insert(_out->end(), p, p + size);
+    }
+    _pos += size;
+}
+
+void archive(StateArchive& a, Vector& v) {
+    a(v.is_ray)(v.to_coord)(v.lightning)(v.lastGlobalLocation)(v.objectLocation);
+    a(v.lastApparentLocation)(v.visible)(v.color)(v.hue)(v.killMe)(v.active);
+    a(v.fromObjectID)(v.fromObject)(v.toObjectID)(v.toObject)(v.toRelativeCoord);
+    a(v.boltState)(v.accuracy)(v.range)(v.thisBoltPoint);
+}
+
+void archive(StateArchive& a, SpaceObject::PixID& p) {
+    const char* data = p.name.data();
+    size_t      size = p.name.size();
+    a(data)(size)(p.hue);
+    if (a.is_loading()) {
+        p.name = pn::string_view{data, static_cast<int>(size)};
+    }
+}
+
+void archive(StateArchive& a, SpaceObject& o) {
+    a(o.attributes)(o.base)(o.keysDown)(o.icon);
+    a(o.direction)(o.directionGoal)(o.turnVelocity)(o.turnFraction)(o.offlineTime);
+    a(o.location)(o.collisionGrid)(o.distanceGrid);
+    a(o.nextFarObject)(o.previousObject)(o.nextObject);
+    a(o.runTimeFlags)(o.destinationLocation)(o.destObject)(o.destObjectDest)(o.asDestination);
+    a(o.destObjectID)(o.destObjectDestID);
+    a(o.localFriendStrength)(o.localFoeStrength)(o.escortStrength);
+    a(o.remoteFriendStrength)(o.remoteFoeStrength);
+    a(o.bestConsideredTargetValue)(o.currentTargetValue)(o.bestConsideredTargetNumber);
+    a(o.timeFromOrigin)(o.idealLocationCalc)(o.originLocation);
+    a(o.motionFraction)(o.velocity)(o.thrust)(o.maxVelocity)(o.absoluteBounds)(o.randomSeed);
+    a(o.frame);
+    a(o._health)(o._energy)(o._battery)(o.warpEnergyCollected);
+    a(o.owner)(o.expires)(o.expire_after)(o.naturalScale)(o.id)(o.rechargeTime)(o.active);
+    a(o.layer)(o.sprite);
+    a(o.distanceFromPlayer)(o.closestDistance)(o.closestObject)(o.targetObject);
+    a(o.targetObjectID)(o.targetAngle)(o.lastTarget)(o.lastTargetDistance);
+    a(o.longestWeaponRange)(o.shortestWeaponRange)(o.engageRange);
+    a(o.presenceState)(o.presence)(o.hitState)(o.cloakState)(o.duty)(o.pix_id);
+    a(o.pulse)(o.beam)(o.special)(o.periodicTime);
+    a(o.myPlayerFlag)(o.seenByPlayerFlags)(o.hostileTowardsFlags);
+    a(o.shieldColor)(o.originalColor);
+}
+
+static void archive_globals(StateArchive& a) {
+    a(g.sync)(g.time)(g.random)(g.level)(g.angle);
+    archive_admirals(a);
+    a(g.admiral);
+    int32_t capacity = g.object_slots.capacity();
+    a(capacity);
+    if (capacity != g.object_slots.capacity()) {
+        throw std::runtime_error("snapshot has a different object capacity");
+    }
+    for (auto o : SpaceObject::all()) {
+        a(*o);
+        if (a.is_loading()) {
+            g.object_slots.set_used(o.number(), o->active != kObjectAvailable);
+        }
+    }
+    if (a.is_loading()) {
+        RecountSpaceObjects();
+    }
+    a(g.ship)(g.root);
+    for (auto v : Vector::all()) {
+        a(*v);
+        if (a.is_loading()) {
+            g.vector_slots.set_used(v.number(), v->active);
+        }
+    }
+    for (auto s : Sprite::all()) {
+        a(*s);
+        if (a.is_loading()) {
+            g.sprite_slots.set_used(s.number(), s->table != NULL);
+        }
+    }
+    if (a.is_loading()) {
+        RebuildSpriteLayers();
+    }
+    a(g.initials)(g.initial_ids)(g.condition_enabled);
+    archive_action_queue(a);
+    a(g.game_over)(g.game_over_at)(g.victor)(g.next_level)(g.victory_text);
+    a(g.radar_count)(g.radar_on)(g.key_mask);
+    a(g.mini.selectLine)(g.mini.currentScreen)(g.mini.clickLine);
+    a(g.zoom)(g.closest)(g.farthest);
+
+    a(globals()->hotKey)(globals()->lastSelectedObject)(globals()->lastSelectedObjectID);
+    a(globals()->next_klaxon);
+
+    a(scaled_screen)(gAbsoluteScale);
+}
+
+Snapshot::Snapshot(PlayerShip& player_ship) : _time{g.time} {
+    StateArchive a = StateArchive::saving(&_data);
+    archive_globals(a);
+    a(player_ship);
+}
+
+void Snapshot::restore(PlayerShip& player_ship) const {
+    StateArchive a = StateArchive::loading(_data);
+    archive_globals(a);
+    a(player_ship);
+
+    // The mini-computer's lines hold callbacks, so they are rebuilt rather than restored.
+    int32_t select_line = g.mini.selectLine;
+    int32_t click_line  = g.mini.clickLine;
+    MiniComputer_SetScreenAndLineHack(g.mini.currentScreen, select_line);
+    g.mini.selectLine = select_line;
+    g.mini.clickLine  = click_line;
+}
+
+}  // namespace antares
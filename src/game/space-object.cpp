@@ -18,8 +18,10 @@
 
 #include "game/space-object.hpp"
 
+#include <array>
 #include <pn/output>
 #include <set>
+#include <unordered_map>
 
 #include "data/base-object.hpp"
 #include "data/plugin.hpp"
@@ -35,7 +37,9 @@
 #include "game/messages.hpp"
 #include "game/minicomputer.hpp"
 #include "game/motion.hpp"
+#include "game/non-player-ship.hpp"
 #include "game/player-ship.hpp"
+#include "game/sim-stats.hpp"
 #include "game/starfield.hpp"
 #include "game/sys.hpp"
 #include "game/vector.hpp"
@@ -45,6 +49,7 @@
 #include "math/rotation.hpp"
 #include "math/special.hpp"
 #include "math/units.hpp"
+#include "video/driver.hpp"
 #include "video/transitions.hpp"
 
 using std::max;
@@ -63,18 +68,120 @@ const Hue kFriendlyColor               = Hue::GREEN;
 const Hue kHostileColor[kMaxPlayerNum] = {Hue::PINK, Hue::RED, Hue::YELLOW, Hue::ORANGE};
 const Hue kNeutralColor                = Hue::SKY_BLUE;
 
+// Number of objects in use, by base type and owner, kept up to date as objects are added,
+// freed, captured, or changed into other types, so that CountObjectsOfBaseType() doesn't have to
+// scan every object. An object counts from when it's added until it's freed, including while it
+// is waiting to be freed, as the scan did.
+class ObjectCounts {
+  public:
+    void clear() {
+        _by_base.clear();
+        _all.fill(0);
+    }
+
+    void add(const SpaceObject& o, int32_t delta) {
+        int  column = o.owner.get() ? o.owner.number() : kNeutral;
+        Row& row    = _by_base[o.base];
+        row[column] += delta;
+        row[kAny] += delta;
+        _all[column] += delta;
+        _all[kAny] += delta;
+    }
+
+    int32_t get(const BaseObject* base, Handle<Admiral> owner) const {
+        int        column = owner.get() ? owner.number() : kAny;
+        const Row* row    = &_all;
+        if (base) {
+            auto it = _by_base.find(base);
+            if (it == _by_base.end()) {
+                return 0;
+            }
+            row = &it->second;
+        }
+        return (*row)[column];
+    }
+
+    bool operator==(const ObjectCounts& other) const {
+        if (_all != other._all) {
+            return false;
+        }
+        for (const auto& kv : _by_base) {
+            auto it = other._by_base.find(kv.first);
+            if (kv.second != ((it == other._by_base.end()) ? Row{} : it->second)) {
+                return false;
+            }
+        }
+        for (const auto& kv : other._by_base) {
+            if (!_by_base.count(kv.first) && (kv.second != Row{})) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+  private:
+    enum { kNeutral = kMaxPlayerNum, kAny = kMaxPlayerNum + 1 };
+    typedef std::array<int32_t, kMaxPlayerNum + 2> Row;
+
+    std::unordered_map<const BaseObject*, Row> _by_base;
+    Row                                        _all = {};
+};
+static ANTARES_GLOBAL ObjectCounts object_counts;
+
+static ObjectCounts scan_object_counts() {
+    ObjectCounts counts;
+    counts.clear();
+    for (auto o : SpaceObject::all()) {
+        if (o->active) {
+            counts.add(*o, +1);
+        }
+    }
+    return counts;
+}
+
 void SpaceObjectHandlingInit() {
-    g.objects.reset(new SpaceObject[kMaxSpaceObject]);
-    ResetAllSpaceObjects();
+    ResetAllSpaceObjects(kMaxSpaceObject);
     reset_action_queue();
 }
 
-void ResetAllSpaceObjects() {
+int32_t object_capacity(const Level& level, sfz::optional<int32_t> override) {
+    int64_t capacity = level.base.object_capacity.value_or(
+            plug.info.object_capacity.value_or(kMaxSpaceObject));
+    if (override.has_value()) {
+        capacity = *override;
+    }
+    if ((capacity < kMaxSpaceObject) || (capacity > kObjectCapacityLimit)) {
+        throw std::runtime_error(pn::format(
+                                         "object_capacity must be between {0} and {1} (was {2})",
+                                         kMaxSpaceObject, kObjectCapacityLimit, capacity)
+                                         .c_str());
+    }
+    return capacity;
+}
+
+void ResetAllSpaceObjects(int32_t capacity) {
+    if (!g.objects || (capacity != g.object_slots.capacity())) {
+        g.objects.reset(new SpaceObject[capacity]);
+    }
+    g.object_slots.reset(capacity);
     g.root = SpaceObject::none();
     for (auto anObject : SpaceObject::all()) {
         anObject->active = kObjectAvailable;
         anObject->sprite = Sprite::none();
     }
+    object_counts.clear();
+    InvalidateManualSelectIndex();
+}
+
+void RecountSpaceObjects() {
+    object_counts = scan_object_counts();
+    InvalidateManualSelectIndex();
+}
+
+void CheckObjectCounts() {
+    if (!(object_counts == scan_object_counts())) {
+        throw std::runtime_error("object counts out of sync with objects");
+    }
 }
 
 BaseObject* BaseObject::get(int number) { return get(pn::dump(number, pn::dump_short)); }
@@ -106,12 +213,7 @@ const BaseObject* get_buildable_object(
 }
 
 static Handle<SpaceObject> next_free_space_object() {
-    for (auto obj : SpaceObject::all()) {
-        if (!obj->active) {
-            return obj;
-        }
-    }
-    return SpaceObject::none();
+    return Handle<SpaceObject>(g.object_slots.allocate());
 }
 
 static uint8_t get_tiny_shade(const SpaceObject& o) {
@@ -136,6 +238,9 @@ static Hue get_tiny_color(const SpaceObject& o) {
 static Handle<SpaceObject> AddSpaceObject(SpaceObject* sourceObject) {
     auto obj = next_free_space_object();
     if (!obj.get()) {
+        if (sys.sim_stats) {
+            ++sys.sim_stats->objects.dropped;
+        }
         return SpaceObject::none();
     }
 
@@ -179,6 +284,7 @@ static Handle<SpaceObject> AddSpaceObject(SpaceObject* sourceObject) {
             g.game_over    = true;
             g.game_over_at = g.time;
             obj->active    = kObjectAvailable;
+            g.object_slots.release(obj.number());
             return SpaceObject::none();
         }
     }
@@ -197,6 +303,8 @@ static Handle<SpaceObject> AddSpaceObject(SpaceObject* sourceObject) {
         g.root->previousObject = obj;
     }
     g.root = obj;
+    object_counts.add(*obj, +1);
+    InvalidateManualSelectIndex();
 
     return obj;
 }
@@ -207,10 +315,13 @@ void RemoveAllSpaceObjects() {
             RemoveSprite(obj->sprite);
             obj->sprite = Sprite::none();
         }
-        obj->active         = kObjectAvailable;
-        obj->nextNearObject = obj->nextFarObject = SpaceObject::none();
-        obj->attributes                          = 0;
+        obj->active        = kObjectAvailable;
+        obj->nextFarObject = SpaceObject::none();
+        obj->attributes    = 0;
     }
+    g.object_slots.reset(g.object_slots.capacity());
+    object_counts.clear();
+    InvalidateManualSelectIndex();
 }
 
 SpaceObject::SpaceObject(
@@ -376,6 +487,9 @@ void SpaceObject::change_base_type(
     int32_t       r;
     NatePixTable* spriteTable;
 
+    if (obj->active) {
+        object_counts.add(*obj, -1);
+    }
     obj->attributes  = base.attributes | (obj->attributes & (kIsPlayerShip | kStaticDestination));
     obj->base        = &base;
     obj->icon        = base.icon;
@@ -421,6 +535,7 @@ void SpaceObject::change_base_type(
     // not setting id
 
     obj->active = kObjectInUse;
+    object_counts.add(*obj, +1);
 
     // not setting sprite, targetObjectNumber, lastTarget, lastTargetDistance;
 
@@ -497,8 +612,8 @@ void SpaceObject::change_base_type(
         obj->sprite->table = spriteTable;
         obj->sprite->icon =
                 base.icon.value_or(BaseObject::Icon{BaseObject::Icon::Shape::SQUARE, 0});
-        obj->sprite->whichLayer = sprite_layer(base);
-        obj->sprite->scale      = sprite_scale(base);
+        SetSpriteLayer(obj->sprite, sprite_layer(base));
+        obj->sprite->scale = sprite_scale(base);
 
         if (obj->attributes & kIsSelfAnimated) {
             obj->sprite->whichShape = more_evil_fixed_to_long(obj->frame.animation.thisShape);
@@ -532,14 +647,10 @@ Handle<SpaceObject> CreateAnySpaceObject(
 }
 
 int32_t CountObjectsOfBaseType(const BaseObject* whichType, Handle<Admiral> owner) {
-    int32_t result = 0;
-    for (auto anObject : SpaceObject::all()) {
-        if (anObject->active && (!whichType || (anObject->base == whichType)) &&
-            (!owner.get() || (anObject->owner == owner))) {
-            ++result;
-        }
+    if (!whichType && !owner.get()) {
+        return g.object_slots.used();
     }
-    return result;
+    return object_counts.get(whichType, owner);
 }
 
 void SpaceObject::alter_health(int32_t amount) {
@@ -604,7 +715,13 @@ void SpaceObject::set_owner(Handle<Admiral> new_owner, bool message) {
     }
 
     Handle<Admiral> old_owner = object->owner;
-    object->owner             = new_owner;
+    if (object->active) {
+        object_counts.add(*object, -1);
+    }
+    object->owner = new_owner;
+    if (object->active) {
+        object_counts.add(*object, +1);
+    }
 
     if (new_owner.get() && (object->attributes & kIsDestination)) {
         if (!new_owner->control().get()) {
@@ -716,6 +833,7 @@ void SpaceObject::destroy() {
         object->attributes &= ~(kHated | kCanEngage | kCanCollide | kCanBeHit);
         exec(object->base->destroy.action, object, SpaceObject::none(), {0, 0});
     } else {
+        sys.video->trigger_snapshot(SnapshotTrigger::OBJECT_DESTROYED);
         AddKillToAdmiral(object);
         if (object->attributes & kReleaseEnergyOnDeath) {
             int16_t energyNum = object->energy() / kEnergyPodAmount;
@@ -763,9 +881,13 @@ void SpaceObject::free() {
             sprite->killMe = true;
         }
     }
-    active         = kObjectAvailable;
-    attributes     = 0;
-    nextNearObject = nextFarObject = SpaceObject::none();
+    if (active) {
+        object_counts.add(*this, -1);
+    }
+    active        = kObjectAvailable;
+    attributes    = 0;
+    nextFarObject = SpaceObject::none();
+    g.object_slots.release(number());
     if (previousObject.get()) {
         auto bObject        = previousObject;
         bObject->nextObject = nextObject;
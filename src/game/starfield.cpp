@@ -26,6 +26,7 @@
 #include "game/globals.hpp"
 #include "game/motion.hpp"
 #include "game/space-object.hpp"
+#include "math/kinematics.hpp"
 #include "math/random.hpp"
 #include "video/driver.hpp"
 
@@ -133,6 +134,35 @@ void Starfield::move(ticks by_units) {
                     g.ship->velocity.v * kFastStarFraction * by_units.count(), gAbsoluteScale),
     };
 
+    // Each star moves independently of the others, so carry all of their fractions at once, with
+    // h and v interleaved. Stars that aren't moving carry zero, and are skipped below.
+    Fixed   velocities[2 * kAllStarNum];
+    Fixed   fractions[2 * kAllStarNum];
+    int32_t wholes[2 * kAllStarNum];
+    for (int32_t i = 0; i < kAllStarNum; ++i) {
+        const scrollStarType* star = &_stars[i];
+        fixedPointType        v    = {Fixed::zero(), Fixed::zero()};
+        if (i >= kSparkStarOffset) {
+            if (star->speed != kNoStar) {
+                v.h = star->velocity.h * by_units.count() + slowVelocity.h;
+                v.v = star->velocity.v * by_units.count() + slowVelocity.v;
+            }
+        } else {
+            switch (star->speed) {
+                case kSlowStarSpeed: v = slowVelocity; break;
+                case kMediumStarSpeed: v = mediumVelocity; break;
+                case kFastStarSpeed: v = fastVelocity; break;
+                default:
+                case kNoStar: break;
+            }
+        }
+        velocities[2 * i]     = v.h;
+        velocities[2 * i + 1] = v.v;
+        fractions[2 * i]      = star->motionFraction.h;
+        fractions[2 * i + 1]  = star->motionFraction.v;
+    }
+    carry_fractions(2 * kAllStarNum, velocities, fractions, fractions, wholes);
+
     for (scrollStarType* star : range(_stars, _stars + kScrollStarNum)) {
         const fixedPointType* velocity;
         switch (star->speed) {
@@ -143,26 +173,11 @@ void Starfield::move(ticks by_units) {
             case kNoStar: continue;
         }
 
-        star->motionFraction.h += velocity->h;
-        star->motionFraction.v += velocity->v;
-
-        int32_t h;
-        if (star->motionFraction.h >= Fixed::zero()) {
-            h = more_evil_fixed_to_long(star->motionFraction.h + Fixed::from_float(0.5));
-        } else {
-            h = more_evil_fixed_to_long(star->motionFraction.h - Fixed::from_float(0.5)) + 1;
-        }
-        star->location.h += h;
-        star->motionFraction.h -= Fixed::from_long(h);
-
-        int32_t v;
-        if (star->motionFraction.v >= Fixed::zero()) {
-            v = more_evil_fixed_to_long(star->motionFraction.v + Fixed::from_float(0.5));
-        } else {
-            v = more_evil_fixed_to_long(star->motionFraction.v - Fixed::from_float(0.5)) + 1;
-        }
-        star->location.v += v;
-        star->motionFraction.v -= Fixed::from_long(v);
+        const int32_t i        = star - _stars;
+        star->motionFraction.h = fractions[2 * i];
+        star->motionFraction.v = fractions[2 * i + 1];
+        star->location.h += wholes[2 * i];
+        star->location.v += wholes[2 * i + 1];
 
         if ((star->location.h < viewport.left) && (star->oldLocation.h < viewport.left)) {
             star->location.h += play_screen.width() - 1;
@@ -211,26 +226,11 @@ void Starfield::move(ticks by_units) {
         }
         star->age -= star->speed * by_units.count();
 
-        star->motionFraction.h += star->velocity.h * by_units.count() + slowVelocity.h;
-        star->motionFraction.v += star->velocity.v * by_units.count() + slowVelocity.v;
-
-        int32_t h;
-        if (star->motionFraction.h >= Fixed::zero()) {
-            h = more_evil_fixed_to_long(star->motionFraction.h + Fixed::from_float(0.5));
-        } else {
-            h = more_evil_fixed_to_long(star->motionFraction.h - Fixed::from_float(0.5)) + 1;
-        }
-        star->location.h += h;
-        star->motionFraction.h -= Fixed::from_long(h);
-
-        int32_t v;
-        if (star->motionFraction.v >= Fixed::zero()) {
-            v = more_evil_fixed_to_long(star->motionFraction.v + Fixed::from_float(0.5));
-        } else {
-            v = more_evil_fixed_to_long(star->motionFraction.v - Fixed::from_float(0.5)) + 1;
-        }
-        star->location.v += v;
-        star->motionFraction.v -= Fixed::from_long(v);
+        const int32_t i        = star - _stars;
+        star->motionFraction.h = fractions[2 * i];
+        star->motionFraction.v = fractions[2 * i + 1];
+        star->location.h += wholes[2 * i];
+        star->location.v += wholes[2 * i + 1];
     }
 }
 
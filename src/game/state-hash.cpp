@@ -0,0 +1,438 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/state-hash.hpp"
+
+#include <algorithm>
+#include <map>
+#include <sfz/sfz.hpp>
+
+#include "data/plugin.hpp"
+#include "game/action.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/space-object.hpp"
+#include "game/sys.hpp"
+#include "lang/defines.hpp"
+
+namespace antares {
+
+namespace {
+
+const uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+const uint64_t kFnvPrime       = 0x00000100000001b3ULL;
+
+uint64_t fnv1a(uint64_t digest, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        digest ^= (value >> (8 * i)) & 0xff;
+        digest *= kFnvPrime;
+    }
+    return digest;
+}
+
+// Folds a digest into a field.
+int32_t fold(uint64_t digest) { return int32_t(uint32_t(digest) ^ uint32_t(digest >> 32)); }
+
+// A hash of the name that `base` was loaded under, which, unlike its address, is the same from
+// run to run. Names are looked up once, and then cached by address until plug.objects changes.
+int32_t base_name_hash(const BaseObject* base) {
+    static ANTARES_GLOBAL std::map<const BaseObject*, int32_t> hashes;
+    if (!base) {
+        return 0;
+    }
+    auto it = hashes.find(base);
+    if ((it == hashes.end()) || (hashes.size() != plug.objects.size())) {
+        hashes.clear();
+        for (const auto& kv : plug.objects) {
+            uint64_t digest = kFnvOffsetBasis;
+            for (int i = 0; i < kv.first.size(); ++i) {
+                digest = fnv1a(digest, uint8_t(kv.first.data()[i]), 1);
+            }
+            hashes[&kv.second] = fold(digest);
+        }
+        it = hashes.find(base);
+        if (it == hashes.end()) {
+            return 0;
+        }
+    }
+    return it->second;
+}
+
+template <typename T>
+struct Field {
+    const char* name;
+    int32_t (*get)(T& x);
+};
+
+const Field<GlobalState> kGlobalFields[] = {
+        {"time", [](GlobalState& s) { return int32_t(s.time.time_since_epoch().count()); }},
+        {"random.seed", [](GlobalState& s) { return s.random.seed; }},
+        {"sync", [](GlobalState& s) { return int32_t(s.sync); }},
+        {"angle", [](GlobalState& s) { return s.angle; }},
+        {"root", [](GlobalState& s) { return int32_t(s.root.number()); }},
+        {"game_over", [](GlobalState& s) { return int32_t(s.game_over); }},
+        {"game_over_at",
+         [](GlobalState& s) { return int32_t(s.game_over_at.time_since_epoch().count()); }},
+        {"victor", [](GlobalState& s) { return int32_t(s.victor.number()); }},
+        {"condition_enabled",
+         [](GlobalState& s) {
+             uint64_t digest = kFnvOffsetBasis;
+             for (bool enabled : s.condition_enabled) {
+                 digest = fnv1a(digest, enabled, 1);
+             }
+             return fold(digest);
+         }},
+};
+
+const Field<Admiral> kAdmiralFields[] = {
+        {"attributes", [](Admiral& a) { return int32_t(a.attributes()); }},
+        {"has_destination", [](Admiral& a) { return int32_t(a.has_destination()); }},
+        {"destinationObject", [](Admiral& a) { return int32_t(a.destinationObject().number()); }},
+        {"destinationObjectID", [](Admiral& a) { return a.destinationObjectID(); }},
+        {"flagship", [](Admiral& a) { return int32_t(a.flagship().number()); }},
+        {"considerShip", [](Admiral& a) { return int32_t(a.considerShip().number()); }},
+        {"considerShipID", [](Admiral& a) { return a.considerShipID(); }},
+        {"considerDestination", [](Admiral& a) { return a.considerDestination(); }},
+        {"buildAtObject", [](Admiral& a) { return int32_t(a.buildAtObject().number()); }},
+        {"cash", [](Admiral& a) { return a.cash().amount.val(); }},
+        {"saveGoal", [](Admiral& a) { return a.saveGoal().amount.val(); }},
+        {"earning_power", [](Admiral& a) { return a.earning_power().val(); }},
+        {"kills", [](Admiral& a) { return a.kills(); }},
+        {"losses", [](Admiral& a) { return a.losses(); }},
+        {"shipsLeft", [](Admiral& a) { return a.shipsLeft(); }},
+        {"score[0]", [](Admiral& a) { return a.score()[0]; }},
+        {"score[1]", [](Admiral& a) { return a.score()[1]; }},
+        {"score[2]", [](Admiral& a) { return a.score()[2]; }},
+        {"blitzkrieg", [](Admiral& a) { return a.blitzkrieg(); }},
+        {"lastFreeEscortStrength", [](Admiral& a) { return a.lastFreeEscortStrength().val(); }},
+        {"thisFreeEscortStrength", [](Admiral& a) { return a.thisFreeEscortStrength().val(); }},
+        {"totalBuildChance", [](Admiral& a) { return a.totalBuildChance().val(); }},
+        {"hopeToBuild", [](Admiral& a) { return int32_t(a.hopeToBuild().has_value()); }},
+        {"active", [](Admiral& a) { return int32_t(a.active()); }},
+        {"cheats", [](Admiral& a) { return int32_t(a.cheats()); }},
+};
+
+const Field<QueuedAction> kActionFields[] = {
+        {"scheduled_time", [](QueuedAction& q) { return int32_t(q.scheduled_time.count()); }},
+        {"subject_id", [](QueuedAction& q) { return q.subject_id; }},
+        {"direct_id", [](QueuedAction& q) { return q.direct_id; }},
+        {"offset.h", [](QueuedAction& q) { return q.offset.h; }},
+        {"offset.v", [](QueuedAction& q) { return q.offset.v; }},
+        {"count", [](QueuedAction& q) { return q.count; }},
+};
+
+const Field<SpaceObject> kObjectFields[] = {
+        {"active", [](SpaceObject& o) { return int32_t(o.active); }},
+        {"id", [](SpaceObject& o) { return o.id; }},
+        {"attributes", [](SpaceObject& o) { return int32_t(o.attributes); }},
+        {"base", [](SpaceObject& o) { return base_name_hash(o.base); }},
+        {"owner", [](SpaceObject& o) { return int32_t(o.owner.number()); }},
+        {"keysDown", [](SpaceObject& o) { return int32_t(o.keysDown); }},
+        {"location.h", [](SpaceObject& o) { return o.location.h; }},
+        {"location.v", [](SpaceObject& o) { return o.location.v; }},
+        {"motionFraction.h", [](SpaceObject& o) { return o.motionFraction.h.val(); }},
+        {"motionFraction.v", [](SpaceObject& o) { return o.motionFraction.v.val(); }},
+        {"velocity.h", [](SpaceObject& o) { return o.velocity.h.val(); }},
+        {"velocity.v", [](SpaceObject& o) { return o.velocity.v.val(); }},
+        {"thrust", [](SpaceObject& o) { return o.thrust.val(); }},
+        {"maxVelocity", [](SpaceObject& o) { return o.maxVelocity.val(); }},
+        {"direction", [](SpaceObject& o) { return o.direction; }},
+        {"directionGoal", [](SpaceObject& o) { return o.directionGoal; }},
+        {"turnVelocity", [](SpaceObject& o) { return o.turnVelocity.val(); }},
+        {"turnFraction", [](SpaceObject& o) { return o.turnFraction.val(); }},
+        {"offlineTime", [](SpaceObject& o) { return o.offlineTime; }},
+        {"runTimeFlags", [](SpaceObject& o) { return o.runTimeFlags; }},
+        {"destinationLocation.h", [](SpaceObject& o) { return o.destinationLocation.h; }},
+        {"destinationLocation.v", [](SpaceObject& o) { return o.destinationLocation.v; }},
+        {"destObject", [](SpaceObject& o) { return int32_t(o.destObject.number()); }},
+        {"destObjectID", [](SpaceObject& o) { return o.destObjectID; }},
+        {"timeFromOrigin", [](SpaceObject& o) { return int32_t(o.timeFromOrigin.count()); }},
+        {"randomSeed", [](SpaceObject& o) { return o.randomSeed.seed; }},
+        {"thisShape", [](SpaceObject& o) { return o.frame.animation.thisShape.val(); }},
+        {"health", [](SpaceObject& o) { return o.health(); }},
+        {"energy", [](SpaceObject& o) { return o.energy(); }},
+        {"battery", [](SpaceObject& o) { return o.battery(); }},
+        {"warpEnergyCollected", [](SpaceObject& o) { return o.warpEnergyCollected; }},
+        {"expire_after", [](SpaceObject& o) { return int32_t(o.expire_after.count()); }},
+        {"rechargeTime", [](SpaceObject& o) { return int32_t(o.rechargeTime.count()); }},
+        {"closestDistance", [](SpaceObject& o) { return int32_t(o.closestDistance); }},
+        {"closestObject", [](SpaceObject& o) { return int32_t(o.closestObject.number()); }},
+        {"targetObject", [](SpaceObject& o) { return int32_t(o.targetObject.number()); }},
+        {"targetObjectID", [](SpaceObject& o) { return o.targetObjectID; }},
+        {"targetAngle", [](SpaceObject& o) { return o.targetAngle; }},
+        {"lastTarget", [](SpaceObject& o) { return int32_t(o.lastTarget.number()); }},
+        {"presenceState", [](SpaceObject& o) { return int32_t(o.presenceState); }},
+        {"hitState", [](SpaceObject& o) { return o.hitState; }},
+        {"cloakState", [](SpaceObject& o) { return o.cloakState; }},
+        {"duty", [](SpaceObject& o) { return int32_t(o.duty); }},
+        {"pulse.ammo", [](SpaceObject& o) { return o.pulse.ammo; }},
+        {"pulse.time",
+         [](SpaceObject& o) { return int32_t(o.pulse.time.time_since_epoch().count()); }},
+        {"beam.ammo", [](SpaceObject& o) { return o.beam.ammo; }},
+        {"beam.time",
+         [](SpaceObject& o) { return int32_t(o.beam.time.time_since_epoch().count()); }},
+        {"special.ammo", [](SpaceObject& o) { return o.special.ammo; }},
+        {"special.time",
+         [](SpaceObject& o) { return int32_t(o.special.time.time_since_epoch().count()); }},
+        {"periodicTime", [](SpaceObject& o) { return int32_t(o.periodicTime.count()); }},
+        {"seenByPlayerFlags", [](SpaceObject& o) { return int32_t(o.seenByPlayerFlags); }},
+        {"hostileTowardsFlags", [](SpaceObject& o) { return int32_t(o.hostileTowardsFlags); }},
+        {"nextObject", [](SpaceObject& o) { return int32_t(o.nextObject.number()); }},
+};
+
+// Hashes the fields of `x` into `r`'s digest for `kind`, and if `dump` is set, also adds them to
+// `r`'s entries.
+template <typename T, size_t N>
+void capture(
+        StateRecord* r, bool dump, StateRecord::Kind kind, int32_t index, T& x,
+        const Field<T> (&fields)[N]) {
+    uint64_t& d = r->kind_digests[kind];
+    d           = fnv1a(d, uint32_t(index), 4);
+    if (!dump) {
+        for (const auto& f : fields) {
+            d = fnv1a(d, uint32_t(f.get(x)), 4);
+        }
+        return;
+    }
+    r->entries.push_back(StateRecord::Entry{kind, index, {}});
+    std::vector<int32_t>& values = r->entries.back().fields;
+    values.reserve(N);
+    for (const auto& f : fields) {
+        values.push_back(f.get(x));
+        d = fnv1a(d, uint32_t(values.back()), 4);
+    }
+}
+
+template <typename T, size_t N>
+pn::string_view field_name(const Field<T> (&fields)[N], int field) {
+    if ((0 <= field) && (field < N)) {
+        return fields[field].name;
+    }
+    return "?";
+}
+
+bool operator<(const StateRecord::Entry& x, const StateRecord::Entry& y) {
+    return (x.kind < y.kind) || ((x.kind == y.kind) && (x.index < y.index));
+}
+
+pn::string describe(const StateRecord::Entry& e) {
+    return pn::format("{0} {1}", state_kind_name(e.kind), e.index);
+}
+
+// Describes the first entry or field that differs between `a` and `b`, which are both dumps.
+pn::string first_difference(const StateRecord& a, const StateRecord& b) {
+    auto x = a.entries.begin(), y = b.entries.begin();
+    while ((x != a.entries.end()) && (y != b.entries.end())) {
+        if (*x < *y) {
+            return pn::format("{0}: only in a", describe(*x));
+        } else if (*y < *x) {
+            return pn::format("{0}: only in b", describe(*y));
+        }
+        for (int i = 0; (i < x->fields.size()) && (i < y->fields.size()); ++i) {
+            if (x->fields[i] != y->fields[i]) {
+                return pn::format(
+                        "{0} {1}: {2} != {3}", describe(*x), state_field_name(x->kind, i),
+                        x->fields[i], y->fields[i]);
+            }
+        }
+        if (x->fields.size() != y->fields.size()) {
+            return pn::format(
+                    "{0}: {1} fields != {2} fields", describe(*x), x->fields.size(),
+                    y->fields.size());
+        }
+        ++x, ++y;
+    }
+    if (x != a.entries.end()) {
+        return pn::format("{0}: only in a", describe(*x));
+    } else if (y != b.entries.end()) {
+        return pn::format("{0}: only in b", describe(*y));
+    }
+    return pn::format("digests differ: {0} != {1}", a.digest, b.digest);
+}
+
+}  // namespace
+
+void StateRecord::seal() {
+    for (uint64_t& d : kind_digests) {
+        d = kFnvOffsetBasis;
+    }
+    for (const auto& e : entries) {
+        uint64_t& d = kind_digests[e.kind];
+        d           = fnv1a(d, uint32_t(e.index), 4);
+        for (int32_t f : e.fields) {
+            d = fnv1a(d, uint32_t(f), 4);
+        }
+    }
+    seal_digest();
+}
+
+void StateRecord::seal_digest() {
+    digest = fnv1a(kFnvOffsetBasis, tick, 8);
+    for (uint64_t d : kind_digests) {
+        digest = fnv1a(digest, d, 8);
+    }
+}
+
+StateRecord capture_state(bool dump) {
+    StateRecord r;
+    r.tick = g.time.time_since_epoch().count();
+    for (uint64_t& d : r.kind_digests) {
+        d = kFnvOffsetBasis;
+    }
+    capture(&r, dump, StateRecord::GLOBAL, 0, g, kGlobalFields);
+    for (auto a : Admiral::all()) {
+        if (a->active()) {
+            capture(&r, dump, StateRecord::ADMIRAL, a.number(), *a, kAdmiralFields);
+        }
+    }
+    int32_t i = 0;
+    for (QueuedAction q : queued_actions()) {
+        capture(&r, dump, StateRecord::ACTION, i++, q, kActionFields);
+    }
+    for (auto o : SpaceObject::all()) {
+        if (o->active != kObjectAvailable) {
+            capture(&r, dump, StateRecord::OBJECT, o.number(), *o, kObjectFields);
+        }
+    }
+    r.seal_digest();
+    return r;
+}
+
+pn::string_view state_kind_name(StateRecord::Kind kind) {
+    switch (kind) {
+        case StateRecord::GLOBAL: return "global";
+        case StateRecord::ADMIRAL: return "admiral";
+        case StateRecord::ACTION: return "action";
+        case StateRecord::OBJECT: return "object";
+    }
+    return "?";
+}
+
+pn::string_view state_field_name(StateRecord::Kind kind, int field) {
+    switch (kind) {
+        case StateRecord::GLOBAL: return field_name(kGlobalFields, field);
+        case StateRecord::ADMIRAL: return field_name(kAdmiralFields, field);
+        case StateRecord::ACTION: return field_name(kActionFields, field);
+        case StateRecord::OBJECT: return field_name(kObjectFields, field);
+    }
+    return "?";
+}
+
+void StateRecord::write_to(pn::output_view out) const {
+    out.write(tick, digest);
+    for (uint64_t d : kind_digests) {
+        out.write(d);
+    }
+    out.write(uint32_t(entries.size()));
+    for (const auto& e : entries) {
+        out.write(uint8_t(e.kind), e.index, uint8_t(e.fields.size()));
+        for (int32_t f : e.fields) {
+            out.write(f);
+        }
+    }
+}
+
+bool read_from(pn::input_view in, StateRecord* record) {
+    if (!in.read(&record->tick, &record->digest)) {
+        return false;
+    }
+    for (uint64_t& d : record->kind_digests) {
+        if (!in.read(&d)) {
+            return false;
+        }
+    }
+    uint32_t count;
+    if (!in.read(&count)) {
+        return false;
+    }
+    record->entries.resize(count);
+    for (auto& e : record->entries) {
+        uint8_t kind, field_count;
+        if (!in.read(&kind, &e.index, &field_count) || (kind > StateRecord::OBJECT)) {
+            return false;
+        }
+        e.kind = static_cast<StateRecord::Kind>(kind);
+        e.fields.resize(field_count);
+        for (int32_t& f : e.fields) {
+            if (!in.read(&f)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+StateDivergence diff_state_logs(pn::input_view a_in, pn::input_view b_in) {
+    StateDivergence result;
+    while (true) {
+        StateRecord a, b;
+        bool        a_ok = read_from(a_in, &a);
+        bool        b_ok = read_from(b_in, &b);
+        if (!a_ok && !b_ok) {
+            return result;
+        } else if (!a_ok || !b_ok) {
+            result.result = StateDivergence::LENGTH;
+            result.tick   = a_ok ? a.tick : b.tick;
+            result.detail = pn::format("{0} ends before tick {1}", a_ok ? "b" : "a", result.tick);
+            return result;
+        } else if (a.tick != b.tick) {
+            result.result = StateDivergence::TICK;
+            result.tick   = std::min(a.tick, b.tick);
+            result.detail = pn::format("tick mismatch: {0} != {1}", a.tick, b.tick);
+            return result;
+        } else if (a.digest != b.digest) {
+            result.result = StateDivergence::STATE;
+            result.tick   = a.tick;
+            for (int k = 0; k < StateRecord::kKindCount; ++k) {
+                if (a.kind_digests[k] != b.kind_digests[k]) {
+                    result.kinds.push_back(static_cast<StateRecord::Kind>(k));
+                }
+            }
+            result.dumped = !a.entries.empty() && !b.entries.empty();
+            if (result.dumped) {
+                result.detail = first_difference(a, b);
+            }
+            return result;
+        }
+        ++result.ticks;
+    }
+}
+
+StateHashLog::StateHashLog(pn::string_view path, int64_t dump_interval, int64_t dump_from)
+        : _out{path, pn::binary}, _dump_interval{dump_interval}, _dump_from{dump_from} {
+    if (!_out) {
+        throw std::runtime_error(pn::format("{0}: couldn't open for writing", path).c_str());
+    }
+    if (sys.state_hash) {
+        throw std::runtime_error("StateHashLog is a singleton");
+    }
+    sys.state_hash = this;
+}
+
+StateHashLog::~StateHashLog() { sys.state_hash = nullptr; }
+
+void StateHashLog::record() {
+    int64_t tick = g.time.time_since_epoch().count();
+    bool    dump = (_dump_from >= 0) && (tick >= _dump_from);
+    if ((_dump_interval > 0) && (tick >= _next_dump)) {
+        dump       = true;
+        _next_dump = tick + _dump_interval;
+    }
+    capture_state(dump).write_to(_out);
+}
+
+}  // namespace antares
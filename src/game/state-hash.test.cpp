@@ -0,0 +1,104 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/state-hash.hpp"
+
+#include <gmock/gmock.h>
+
+using testing::ElementsAre;
+using testing::Eq;
+using testing::IsEmpty;
+
+namespace antares {
+namespace {
+
+using StateHashTest = testing::Test;
+
+// A record with game-wide state and one object, whose location.h (field 6) is `h`.
+StateRecord record(int64_t tick, int32_t h, bool dump) {
+    StateRecord r;
+    r.tick = tick;
+    r.entries.push_back(StateRecord::Entry{StateRecord::GLOBAL, 0, {int32_t(tick), 7}});
+    r.entries.push_back(StateRecord::Entry{StateRecord::OBJECT, 5, {1, 12, 0, 0, 0, 0, h, 40}});
+    r.seal();
+    if (!dump) {
+        r.entries.clear();
+    }
+    return r;
+}
+
+// A log of ticks 0, 3, 6, ... 27, where the object moves to `diverged_h` at `diverge_at`.
+pn::data state_log(int64_t diverge_at, int32_t diverged_h, bool dump) {
+    pn::data data;
+    for (int64_t tick = 0; tick < 30; tick += 3) {
+        int32_t h = (tick < diverge_at) ? 100 : diverged_h;
+        record(tick, h, dump).write_to(data.output());
+    }
+    return data;
+}
+
+TEST_F(StateHashTest, Same) {
+    pn::data        a = state_log(30, 100, false), b = state_log(30, 100, false);
+    StateDivergence d = diff_state_logs(a.input(), b.input());
+    EXPECT_THAT(d.result, Eq(StateDivergence::NONE));
+    EXPECT_THAT(d.ticks, Eq(10));
+}
+
+TEST_F(StateHashTest, FirstDivergentField) {
+    pn::data        a = state_log(9, 100, true), b = state_log(9, 101, true);
+    StateDivergence d = diff_state_logs(a.input(), b.input());
+    EXPECT_THAT(d.result, Eq(StateDivergence::STATE));
+    EXPECT_THAT(d.ticks, Eq(3));
+    EXPECT_THAT(d.tick, Eq(9));
+    EXPECT_THAT(d.kinds, ElementsAre(StateRecord::OBJECT));
+    EXPECT_TRUE(d.dumped);
+    EXPECT_THAT(pn::string_view{d.detail}, Eq("object 5 location.h: 100 != 101"));
+}
+
+// Without dumps, the divergent tick and subsystem are still found, but not the field.
+TEST_F(StateHashTest, HashesOnly) {
+    pn::data        a = state_log(9, 100, false), b = state_log(9, 101, false);
+    StateDivergence d = diff_state_logs(a.input(), b.input());
+    EXPECT_THAT(d.result, Eq(StateDivergence::STATE));
+    EXPECT_THAT(d.tick, Eq(9));
+    EXPECT_THAT(d.kinds, ElementsAre(StateRecord::OBJECT));
+    EXPECT_FALSE(d.dumped);
+    EXPECT_THAT(pn::string_view{d.detail}, IsEmpty());
+}
+
+TEST_F(StateHashTest, Length) {
+    pn::data a = state_log(30, 100, false), b;
+    for (int64_t tick = 0; tick < 15; tick += 3) {
+        record(tick, 100, false).write_to(b.output());
+    }
+    StateDivergence d = diff_state_logs(a.input(), b.input());
+    EXPECT_THAT(d.result, Eq(StateDivergence::LENGTH));
+    EXPECT_THAT(d.tick, Eq(15));
+    EXPECT_THAT(pn::string_view{d.detail}, Eq("b ends before tick 15"));
+}
+
+// A dump has the same digests as the record without one, so logs with dumps at different
+// ticks can still be compared.
+TEST_F(StateHashTest, DumpsDoNotChangeDigests) {
+    StateRecord dumped = record(6, 100, true), hashed = record(6, 100, false);
+    EXPECT_THAT(dumped.digest, Eq(hashed.digest));
+    pn::data a = state_log(30, 100, true), b = state_log(30, 100, false);
+    EXPECT_THAT(diff_state_logs(a.input(), b.input()).result, Eq(StateDivergence::NONE));
+}
+
+}  // namespace
+}  // namespace antares
@@ -0,0 +1,229 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/target-index.hpp"
+
+#include <algorithm>
+
+#include "math/macros.hpp"
+#include "math/rotation.hpp"
+#include "math/special.hpp"
+#include "math/units.hpp"
+
+namespace antares {
+
+namespace {
+
+const uint64_t kNoDistance  = 0x3fffffff3fffffffull;
+const int32_t  kMaxGridSize = 64;
+
+// The best candidate so far; ties go to the lowest rank (the first reached when cycling).
+struct Best {
+    int32_t  index = -1;
+    uint64_t distance;
+    int32_t  rank;
+
+    bool beaten_by(uint64_t d, int32_t r) const {
+        if (index < 0) {
+            return d < kNoDistance;
+        }
+        return (d < distance) || ((d == distance) && (r < rank));
+    }
+};
+
+// Index of the cell holding `offset`, rounding down for points before the grid.
+int64_t cell_of(int64_t offset, int32_t shift) {
+    if (offset >= 0) {
+        return offset >> shift;
+    }
+    return -((-offset - 1) >> shift) - 1;
+}
+
+// Lowest possible squared distance from a point to anything in a cell `ring` cells away.
+uint64_t ring_distance(int64_t ring, int32_t shift) {
+    if (ring <= 1) {
+        return 0;
+    }
+    uint64_t gap = (ring - 1) << shift;
+    if (gap > 0xffffffffull) {
+        return ~0ull;
+    }
+    return gap * gap;
+}
+
+}  // namespace
+
+void TargetIndex::build(const std::vector<Entry>& entries) {
+    _cells.clear();
+    _entries.clear();
+    _order.clear();
+    _order_of.clear();
+    if (entries.empty()) {
+        _size = 0;
+        return;
+    }
+
+    Point   max        = _min = entries[0].location;
+    int32_t max_number = 0;
+    for (const Entry& e : entries) {
+        _min.h     = std::min(_min.h, e.location.h);
+        _min.v     = std::min(_min.v, e.location.v);
+        max.h      = std::max(max.h, e.location.h);
+        max.v      = std::max(max.v, e.location.v);
+        max_number = std::max(max_number, e.number);
+    }
+
+    // About one object per cell, up to kMaxGridSize cells on a side.
+    _size = 1;
+    while ((_size < kMaxGridSize) && ((_size * _size) < entries.size())) {
+        _size *= 2;
+    }
+    int64_t extent = std::max(int64_t{max.h} - int64_t{_min.h}, int64_t{max.v} - int64_t{_min.v});
+    _shift = 0;
+    while ((extent >> _shift) >= _size) {
+        ++_shift;
+    }
+
+    // Counting sort by cell, keeping g.root order within each cell. _scratch holds the cell of
+    // each entry, then the next free position in each cell.
+    const int32_t cell_count = _size * _size;
+    _scratch.resize(entries.size() + cell_count);
+    int32_t* cell = &_scratch[0];
+    int32_t* next = &_scratch[entries.size()];
+    _cells.assign(cell_count + 1, 0);
+    _order_of.assign(max_number + 1, -1);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        int32_t x = (int64_t{entries[i].location.h} - _min.h) >> _shift;
+        int32_t y = (int64_t{entries[i].location.v} - _min.v) >> _shift;
+        cell[i]   = (y * _size) + x;
+        ++_cells[cell[i] + 1];
+        _order_of[entries[i].number] = i;
+    }
+    for (size_t c = 1; c < _cells.size(); ++c) {
+        _cells[c] += _cells[c - 1];
+    }
+    std::copy(_cells.begin(), _cells.end() - 1, next);
+    _entries.resize(entries.size());
+    _order.resize(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        int32_t j   = next[cell[i]]++;
+        _entries[j] = entries[i];
+        _order[j]   = i;
+    }
+}
+
+int32_t TargetIndex::select(
+        const Query& q, const std::function<bool(int32_t number)>& eligible) const {
+    const int32_t count = _entries.size();
+    if (count == 0) {
+        return -1;
+    }
+    int32_t start = 0;
+    if ((q.start >= 0) && (q.start < _order_of.size()) && (_order_of[q.start] >= 0)) {
+        start = _order_of[q.start];
+    }
+
+    int64_t ox    = cell_of(int64_t{q.origin.h} - _min.h, _shift);
+    int64_t oy    = cell_of(int64_t{q.origin.v} - _min.v, _shift);
+    int64_t rings = std::max(
+            std::max(ABS<int64_t>(ox), ABS<int64_t>(ox - (_size - 1))),
+            std::max(ABS<int64_t>(oy), ABS<int64_t>(oy - (_size - 1))));
+
+    Best closest, farther;
+    auto consider = [&](int64_t x, int64_t y) {
+        if ((x < 0) || (x >= _size) || (y < 0) || (y >= _size)) {
+            return;
+        }
+        int32_t c = (y * _size) + x;
+        for (int32_t i = _cells[c]; i < _cells[c + 1]; ++i) {
+            const Entry& e          = _entries[i];
+            uint64_t     d          = distance(q.origin, e.location);
+            int32_t      rank       = (_order[i] - start + count) % count;
+            bool         is_closest = closest.beaten_by(d, rank);
+            bool         is_farther = (d > q.farther_than) && farther.beaten_by(d, rank);
+            if ((is_closest || is_farther) && eligible(e.number) &&
+                in_cone(q.origin, e.location, q.direction)) {
+                if (is_closest) {
+                    closest.index    = i;
+                    closest.distance = d;
+                    closest.rank     = rank;
+                }
+                if (is_farther) {
+                    farther.index    = i;
+                    farther.distance = d;
+                    farther.rank     = rank;
+                }
+            }
+        }
+    };
+
+    for (int64_t r = 0; r <= rings; ++r) {
+        uint64_t nearest = ring_distance(r, _shift);
+        if (((closest.index >= 0) && (nearest > closest.distance)) &&
+            ((farther.index >= 0) && (nearest > farther.distance))) {
+            break;
+        }
+        for (int64_t x = ox - r; x <= ox + r; ++x) {
+            consider(x, oy - r);
+            if (r > 0) {
+                consider(x, oy + r);
+            }
+        }
+        for (int64_t y = oy - r + 1; y < oy + r; ++y) {
+            consider(ox - r, y);
+            consider(ox + r, y);
+        }
+    }
+
+    int32_t closest_number = (closest.index >= 0) ? _entries[closest.index].number : -1;
+    int32_t next_number    = (farther.index >= 0) ? _entries[farther.index].number : -1;
+    if (((next_number < 0) && (closest_number >= 0)) || (next_number == q.current)) {
+        next_number = closest_number;
+    }
+    return next_number;
+}
+
+uint64_t TargetIndex::distance(Point a, Point b) {
+    uint32_t xdiff = ABS<int>(a.h - b.h);
+    uint32_t ydiff = ABS<int>(a.v - b.v);
+    if ((xdiff > kMaximumRelevantDistance) || (ydiff > kMaximumRelevantDistance)) {
+        return MyWideMul<uint64_t>(xdiff, xdiff) + MyWideMul<uint64_t>(ydiff, ydiff);
+    } else {
+        return ydiff * ydiff + xdiff * xdiff;
+    }
+}
+
+bool TargetIndex::in_cone(Point from, Point to, int32_t direction) {
+    int32_t hdif = from.h - to.h;
+    int32_t vdif = from.v - to.v;
+    while ((ABS(hdif) > kMaximumAngleDistance) || (ABS(vdif) > kMaximumAngleDistance)) {
+        hdif >>= 1;
+        vdif >>= 1;
+    }
+
+    int16_t angle = AngleFromSlope(MyFixRatio(hdif, vdif));
+
+    if (hdif > 0) {
+        mAddAngle(angle, 180);
+    } else if ((hdif == 0) && (vdif > 0)) {
+        angle = 0;
+    }
+
+    return ABS(mAngleDifference(angle, direction)) < 30;
+}
+
+}  // namespace antares
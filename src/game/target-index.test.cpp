@@ -0,0 +1,265 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/target-index.hpp"
+
+#include <gmock/gmock.h>
+#include <functional>
+#include <vector>
+
+#include "math/macros.hpp"
+#include "math/rotation.hpp"
+#include "math/special.hpp"
+#include "math/units.hpp"
+
+using testing::Eq;
+
+namespace antares {
+namespace {
+
+using TargetIndexTest = testing::Test;
+
+using Entry = TargetIndex::Entry;
+using Query = TargetIndex::Query;
+
+struct Object {
+    int32_t  number;
+    Point    location;
+    uint32_t attributes;
+    uint32_t seen;   // seenByPlayerFlags
+    int32_t  owner;  // admiral number, or -1
+};
+
+// What GetManualSelectObject() asks for, besides the TargetIndex query itself.
+struct Filter {
+    int32_t    source;
+    int32_t    owner;
+    uint32_t   inclusive;
+    uint32_t   exclusive;
+    Allegiance allegiance;
+};
+
+// The linear scan that GetManualSelectObject() did before TargetIndex, over `objects` in g.root
+// order instead of the g.root list itself. `start` is an index into `objects`.
+int32_t legacy_select(
+        const std::vector<Object>& objects, const Filter& f, const Query& q, int32_t start) {
+    const uint32_t myOwnerFlag = 1 << f.owner;
+
+    uint64_t wideClosestDistance = 0x3fffffff3fffffffull;
+    uint64_t wideFartherDistance = 0x3fffffff3fffffffull;
+
+    int32_t nextShipOut = -1, closestShip = -1;
+    int32_t i           = start;
+    do {
+        const Object& anObject = objects[i];
+        if ((anObject.number != f.source) && (anObject.seen & myOwnerFlag) &&
+            (anObject.attributes & f.inclusive) && !(anObject.attributes & f.exclusive) &&
+            ((f.allegiance == FRIENDLY_OR_HOSTILE) ||
+             ((f.allegiance == FRIENDLY) && (anObject.owner == f.owner)) ||
+             ((f.allegiance == HOSTILE) && (anObject.owner != f.owner)))) {
+            uint32_t xdiff = ABS<int>(q.origin.h - anObject.location.h);
+            uint32_t ydiff = ABS<int>(q.origin.v - anObject.location.v);
+
+            uint64_t thisWideDistance;
+            if ((xdiff > kMaximumRelevantDistance) || (ydiff > kMaximumRelevantDistance)) {
+                thisWideDistance =
+                        MyWideMul<uint64_t>(xdiff, xdiff) + MyWideMul<uint64_t>(ydiff, ydiff);
+            } else {
+                thisWideDistance = ydiff * ydiff + xdiff * xdiff;
+            }
+
+            bool is_closest = thisWideDistance < wideClosestDistance;
+            bool is_closest_far_object =
+                    (thisWideDistance > q.farther_than) &&
+                    (wideFartherDistance > thisWideDistance);
+
+            if (is_closest || is_closest_far_object) {
+                int32_t hdif = q.origin.h - anObject.location.h;
+                int32_t vdif = q.origin.v - anObject.location.v;
+                while ((ABS(hdif) > kMaximumAngleDistance) ||
+                       (ABS(vdif) > kMaximumAngleDistance)) {
+                    hdif >>= 1;
+                    vdif >>= 1;
+                }
+
+                int16_t angle = AngleFromSlope(MyFixRatio(hdif, vdif));
+
+                if (hdif > 0) {
+                    mAddAngle(angle, 180);
+                } else if ((hdif == 0) && (vdif > 0)) {
+                    angle = 0;
+                }
+
+                if (ABS(mAngleDifference(angle, q.direction)) < 30) {
+                    if (is_closest) {
+                        closestShip         = anObject.number;
+                        wideClosestDistance = thisWideDistance;
+                    }
+
+                    if (is_closest_far_object) {
+                        nextShipOut         = anObject.number;
+                        wideFartherDistance = thisWideDistance;
+                    }
+                }
+            }
+        }
+        i = (i + 1) % objects.size();
+    } while (i != start);
+
+    if (((nextShipOut < 0) && (closestShip >= 0)) || (nextShipOut == q.current)) {
+        nextShipOut = closestShip;
+    }
+
+    return nextShipOut;
+}
+
+std::vector<Entry> entries(const std::vector<Object>& objects) {
+    std::vector<Entry> result;
+    for (const Object& o : objects) {
+        result.push_back(Entry{o.number, o.location});
+    }
+    return result;
+}
+
+// Answers `eligible` the way GetManualSelectObject() does, from `objects` instead of g.objects.
+std::function<bool(int32_t)> eligible(const std::vector<Object>& objects, const Filter& f) {
+    return [&objects, f](int32_t number) {
+        const uint32_t myOwnerFlag = 1 << f.owner;
+        for (const Object& o : objects) {
+            if (o.number == number) {
+                return (o.number != f.source) && (o.seen & myOwnerFlag) &&
+                       (o.attributes & f.inclusive) && !(o.attributes & f.exclusive) &&
+                       ((f.allegiance == FRIENDLY_OR_HOSTILE) ||
+                        ((f.allegiance == FRIENDLY) && (o.owner == f.owner)) ||
+                        ((f.allegiance == HOSTILE) && (o.owner != f.owner)));
+            }
+        }
+        return false;
+    };
+}
+
+Filter filter(const Object& source, Allegiance allegiance) {
+    return Filter{source.number, source.owner, 0x1, 0x2, allegiance};
+}
+
+Query query(const Object& source, int32_t direction) {
+    Query q;
+    q.origin       = source.location;
+    q.direction    = direction;
+    q.farther_than = 0;
+    q.start        = -1;
+    q.current      = -1;
+    return q;
+}
+
+TEST_F(TargetIndexTest, Empty) {
+    std::vector<Object> objects = {{0, Point{0, 0}, 0x1, 0x1, 0}};
+    TargetIndex         index;
+    index.build({});
+    auto any = eligible(objects, filter(objects[0], FRIENDLY_OR_HOSTILE));
+    EXPECT_THAT(index.select(query(objects[0], 0), any), Eq(-1));
+}
+
+// Straight up is 0 degrees, and angles increase clockwise.
+TEST_F(TargetIndexTest, Cone) {
+    const int32_t       c       = 0x40000000;
+    std::vector<Object> objects = {
+            {0, Point{c, c}, 0x1, 0x1, 0},        {1, Point{c, c - 100}, 0x1, 0x1, 0},
+            {2, Point{c + 100, c}, 0x1, 0x1, 0},  {3, Point{c, c + 100}, 0x1, 0x1, 0},
+            {4, Point{c - 100, c}, 0x1, 0x1, 0},  {5, Point{c, c - 50}, 0x3, 0x1, 0},
+    };
+    TargetIndex index;
+    index.build(entries(objects));
+    auto any = eligible(objects, filter(objects[0], FRIENDLY_OR_HOSTILE));
+    EXPECT_THAT(index.select(query(objects[0], 0), any), Eq(1));
+    EXPECT_THAT(index.select(query(objects[0], 90), any), Eq(2));
+    EXPECT_THAT(index.select(query(objects[0], 180), any), Eq(3));
+    EXPECT_THAT(index.select(query(objects[0], 270), any), Eq(4));
+    EXPECT_THAT(index.select(query(objects[0], 45), any), Eq(-1));
+}
+
+// Random fields, from tightly packed to spread across the whole map, checking every query
+// against the linear scan.
+TEST_F(TargetIndexTest, MatchesLinearScan) {
+    uint32_t seed = 1;
+    auto     next = [&seed](uint32_t n) {
+        seed = (seed * 1103515245) + 12345;
+        return (seed >> 8) % n;
+    };
+
+    for (int32_t spread : {16, 1000, 50000, 262144}) {
+        for (int32_t count : {1, 2, 10, 100, 1000}) {
+            std::vector<Object> objects;
+            for (int32_t i = 0; i < count; ++i) {
+                Object o;
+                o.number     = (i * 7919) % 16384;
+                o.location.h = 0x3ffe0000 + next(spread);
+                o.location.v = 0x3ffe0000 + next(spread);
+                o.attributes = next(4);
+                o.seen       = next(4);
+                o.owner      = static_cast<int32_t>(next(3)) - 1;
+                objects.push_back(o);
+            }
+            TargetIndex index;
+            index.build(entries(objects));
+
+            for (int32_t k = 0; k < 50; ++k) {
+                const Object& source = objects[next(count)];
+                Filter        f      = filter(source, static_cast<Allegiance>(next(3)));
+                Query         q      = query(source, next(360));
+
+                f.owner       = next(2);
+                int32_t start = next(count);
+                q.start       = objects[start].number;
+                q.current     = objects[start].number;
+                if (next(2)) {
+                    q.farther_than = TargetIndex::distance(q.origin, objects[start].location);
+                }
+                EXPECT_THAT(
+                        index.select(q, eligible(objects, f)),
+                        Eq(legacy_select(objects, f, q, start)))
+                        << "spread " << spread << ", count " << count << ", query " << k;
+            }
+        }
+    }
+}
+
+// The index is built once and then queried while objects come and go, as between major ticks.
+// Objects that are no longer eligible are skipped without changing the cycling order.
+TEST_F(TargetIndexTest, Reused) {
+    const int32_t       c       = 0x40000000;
+    std::vector<Object> objects = {
+            {0, Point{c, c}, 0x1, 0x1, 0},
+            {3, Point{c, c - 100}, 0x1, 0x1, 0},
+            {7, Point{c + 10, c - 90}, 0x1, 0x1, 0},
+            {9, Point{c - 10, c - 90}, 0x1, 0x1, 0},
+    };
+    TargetIndex index;
+    index.build(entries(objects));
+
+    Filter f = filter(objects[0], FRIENDLY_OR_HOSTILE);
+    Query  q = query(objects[0], 0);
+    q.start  = 7;
+    EXPECT_THAT(index.select(q, eligible(objects, f)), Eq(legacy_select(objects, f, q, 2)));
+
+    objects[2].attributes = 0;
+    EXPECT_THAT(index.select(q, eligible(objects, f)), Eq(legacy_select(objects, f, q, 2)));
+    EXPECT_THAT(index.select(q, eligible(objects, f)), Eq(9));
+}
+
+}  // namespace
+}  // namespace antares
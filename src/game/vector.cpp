@@ -27,8 +27,11 @@
 #include "drawing/sprite-handling.hpp"
 #include "game/globals.hpp"
 #include "game/motion.hpp"
+#include "game/sim-stats.hpp"
 #include "game/space-object.hpp"
+#include "game/sys.hpp"
 #include "lang/casts.hpp"
+#include "lang/defines.hpp"
 #include "math/random.hpp"
 #include "math/rotation.hpp"
 #include "math/units.hpp"
@@ -73,78 +76,96 @@ Vector* Vector::get(int number) {
 
 Vector::Vector() : killMe(false), active(false) {}
 
-void Vectors::init() { g.vectors.reset(new Vector[Vector::size]); }
+size_t ANTARES_GLOBAL Vector::size = 0;
 
-void Vectors::reset() {
+UsedHandleList<Vector> Vector::live() { return UsedHandleList<Vector>(g.vector_slots); }
+
+void Vectors::init() { reset(kMaxSpaceObject); }
+
+void Vectors::reset(int32_t object_capacity) {
+    // At least one per object, but never fewer than the original 256.
+    size_t size = std::max<size_t>(256, object_capacity);
+    if (!g.vectors || (size != Vector::size)) {
+        g.vectors.reset(new Vector[size]);
+        Vector::size = size;
+    }
     for (auto vector : Vector::all()) {
         clear(*vector);
     }
+    g.vector_slots.reset(size);
+}
+
+// Claims the lowest free vector, or counts a drop if there is none.
+static Handle<Vector> next_free_vector() {
+    Handle<Vector> vector(g.vector_slots.allocate());
+    if (!vector.get() && sys.sim_stats) {
+        ++sys.sim_stats->vectors.dropped;
+    }
+    return vector;
 }
 
 Handle<Vector> Vectors::add(Point* location, const BaseObject::Ray& r) {
-    for (auto vector : Vector::all()) {
-        if (!vector->active) {
-            vector->lastGlobalLocation   = *location;
-            vector->objectLocation       = *location;
-            vector->lastApparentLocation = *location;
-            vector->killMe               = false;
-            vector->active               = true;
-            vector->visible              = r.hue.has_value();
-            vector->color                = RgbColor::clear();
-            vector->hue                  = r.hue;
-
-            vector->thisBoltPoint[0] = vector->thisBoltPoint[kBoltPointNum - 1] =
-                    scale_to_viewport(*location);
-
-            vector->is_ray          = true;
-            vector->to_coord        = (r.to == BaseObject::Ray::To::COORD);
-            vector->lightning       = r.lightning;
-            vector->accuracy        = r.accuracy;
-            vector->range           = r.range;
-            vector->fromObjectID    = -1;
-            vector->fromObject      = SpaceObject::none();
-            vector->toObjectID      = -1;
-            vector->toObject        = SpaceObject::none();
-            vector->toRelativeCoord = Point(0, 0);
-            vector->boltState       = 0;
-
-            return vector;
-        }
+    auto vector = next_free_vector();
+    if (!vector.get()) {
+        return Vector::none();
     }
 
-    return Vector::none();
+    vector->lastGlobalLocation   = *location;
+    vector->objectLocation       = *location;
+    vector->lastApparentLocation = *location;
+    vector->killMe               = false;
+    vector->active               = true;
+    vector->visible              = r.hue.has_value();
+    vector->color                = RgbColor::clear();
+    vector->hue                  = r.hue;
+
+    vector->thisBoltPoint[0] = vector->thisBoltPoint[kBoltPointNum - 1] =
+            scale_to_viewport(*location);
+
+    vector->is_ray          = true;
+    vector->to_coord        = (r.to == BaseObject::Ray::To::COORD);
+    vector->lightning       = r.lightning;
+    vector->accuracy        = r.accuracy;
+    vector->range           = r.range;
+    vector->fromObjectID    = -1;
+    vector->fromObject      = SpaceObject::none();
+    vector->toObjectID      = -1;
+    vector->toObject        = SpaceObject::none();
+    vector->toRelativeCoord = Point(0, 0);
+    vector->boltState       = 0;
+
+    return vector;
 }
 
 Handle<Vector> Vectors::add(Point* location, const BaseObject::Bolt& b) {
-    for (auto vector : Vector::all()) {
-        if (!vector->active) {
-            vector->lastGlobalLocation   = *location;
-            vector->objectLocation       = *location;
-            vector->lastApparentLocation = *location;
-            vector->killMe               = false;
-            vector->active               = true;
-            vector->visible              = (b.color != RgbColor::clear());
-            vector->hue                  = sfz::nullopt;
-            vector->color                = b.color;
-
-            vector->thisBoltPoint[0] = vector->thisBoltPoint[kBoltPointNum - 1] =
-                    scale_to_viewport(*location);
-
-            vector->is_ray          = false;
-            vector->to_coord        = false;
-            vector->lightning       = false;
-            vector->fromObjectID    = -1;
-            vector->fromObject      = SpaceObject::none();
-            vector->toObjectID      = -1;
-            vector->toObject        = SpaceObject::none();
-            vector->toRelativeCoord = Point(0, 0);
-            vector->boltState       = 0;
-
-            return vector;
-        }
+    auto vector = next_free_vector();
+    if (!vector.get()) {
+        return Vector::none();
     }
 
-    return Vector::none();
+    vector->lastGlobalLocation   = *location;
+    vector->objectLocation       = *location;
+    vector->lastApparentLocation = *location;
+    vector->killMe               = false;
+    vector->active               = true;
+    vector->visible              = (b.color != RgbColor::clear());
+    vector->hue                  = sfz::nullopt;
+    vector->color                = b.color;
+
+    vector->thisBoltPoint[0] = vector->thisBoltPoint[kBoltPointNum - 1] =
+            scale_to_viewport(*location);
+
+    vector->is_ray          = false;
+    vector->to_coord        = false;
+    vector->lightning       = false;
+    vector->fromObjectID    = -1;
+    vector->fromObject      = SpaceObject::none();
+    vector->toObjectID      = -1;
+    vector->toObject        = SpaceObject::none();
+    vector->toRelativeCoord = Point(0, 0);
+    vector->boltState       = 0;
+
+    return vector;
 }
 
 void Vectors::set_attributes(Handle<SpaceObject> vectorObject, Handle<SpaceObject> sourceObject) {
@@ -193,42 +214,40 @@ void Vectors::set_attributes(Handle<SpaceObject> vectorObject, Handle<SpaceObjec
 }
 
 void Vectors::update() {
-    for (auto vector : Vector::all()) {
-        if (vector->active) {
-            if (vector->lastApparentLocation != vector->objectLocation) {
-                vector->thisBoltPoint[0] = scale_to_viewport(vector->objectLocation);
-                vector->thisBoltPoint[kBoltPointNum - 1] =
-                        scale_to_viewport(vector->lastApparentLocation);
-                vector->lastApparentLocation = vector->objectLocation;
-            }
+    for (auto vector : Vector::live()) {
+        if (vector->lastApparentLocation != vector->objectLocation) {
+            vector->thisBoltPoint[0] = scale_to_viewport(vector->objectLocation);
+            vector->thisBoltPoint[kBoltPointNum - 1] =
+                    scale_to_viewport(vector->lastApparentLocation);
+            vector->lastApparentLocation = vector->objectLocation;
+        }
 
-            if (!vector->killMe) {
-                if (vector->visible) {
-                    if (vector->hue.has_value()) {
-                        vector->boltState++;
-                        if (vector->boltState > 24)
-                            vector->boltState = -24;
-                        uint8_t currentColor = static_cast<int>(*vector->hue) << 4;
-                        if (vector->boltState < 0)
-                            currentColor += (-vector->boltState) >> 1;
-                        else
-                            currentColor += vector->boltState >> 1;
-                        vector->color = GetRGBTranslateColor(currentColor);
-                    }
-                    if (vector->lightning) {
-                        auto&   p     = vector->thisBoltPoint;
-                        Point   begin = p[0];
-                        Point   end   = p[kBoltPointNum - 1];
-                        Size    span{end.h - begin.h, end.v - begin.v};
-                        int32_t inaccuracy =
-                                max(abs(span.width), abs(span.height)) / kBoltPointNum / 2;
-
-                        for (int j : range(1, kBoltPointNum - 1)) {
-                            p[j].h = begin.h + ((span.width * j) / kBoltPointNum) - inaccuracy +
-                                     Randomize(inaccuracy * 2);
-                            p[j].v = begin.v + ((span.height * j) / kBoltPointNum) - inaccuracy +
-                                     Randomize(inaccuracy * 2);
-                        }
+        if (!vector->killMe) {
+            if (vector->visible) {
+                if (vector->hue.has_value()) {
+                    vector->boltState++;
+                    if (vector->boltState > 24)
+                        vector->boltState = -24;
+                    uint8_t currentColor = static_cast<int>(*vector->hue) << 4;
+                    if (vector->boltState < 0)
+                        currentColor += (-vector->boltState) >> 1;
+                    else
+                        currentColor += vector->boltState >> 1;
+                    vector->color = GetRGBTranslateColor(currentColor);
+                }
+                if (vector->lightning) {
+                    auto&   p     = vector->thisBoltPoint;
+                    Point   begin = p[0];
+                    Point   end   = p[kBoltPointNum - 1];
+                    Size    span{end.h - begin.h, end.v - begin.v};
+                    int32_t inaccuracy =
+                            max(abs(span.width), abs(span.height)) / kBoltPointNum / 2;
+
+                    for (int j : range(1, kBoltPointNum - 1)) {
+                        p[j].h = begin.h + ((span.width * j) / kBoltPointNum) - inaccuracy +
+                                 Randomize(inaccuracy * 2);
+                        p[j].v = begin.v + ((span.height * j) / kBoltPointNum) - inaccuracy +
+                                 Randomize(inaccuracy * 2);
                     }
                 }
             }
@@ -238,8 +257,8 @@ void Vectors::update() {
 
 void Vectors::draw() {
     Lines lines;
-    for (auto vector : Vector::all()) {
-        if (vector->active && !vector->killMe) {
+    for (auto vector : Vector::live()) {
+        if (!vector->killMe) {
             if (vector->visible) {
                 const auto& p = vector->thisBoltPoint;
                 if (vector->lightning) {
@@ -255,8 +274,11 @@ void Vectors::draw() {
 }
 
 void Vectors::cull() {
-    for (auto vector : Vector::all()) {
-        vector->active = vector->active && !vector->killMe;
+    for (auto vector : Vector::live()) {
+        if (vector->killMe) {
+            vector->active = false;
+            g.vector_slots.release(vector.number());
+        }
     }
 }
 
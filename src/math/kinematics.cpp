@@ -0,0 +1,136 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "math/kinematics.hpp"
+
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ANTARES_CARRY_X86 1
+#include <immintrin.h>
+#endif
+
+namespace antares {
+
+namespace {
+
+void carry_scalar(
+        int32_t n, const Fixed* velocity, const Fixed* fraction, Fixed* out_fraction,
+        int32_t* whole) {
+    for (int32_t i = 0; i < n; ++i) {
+        Fixed f         = fraction[i];
+        whole[i]        = carry_fraction(velocity[i], &f);
+        out_fraction[i] = f;
+    }
+}
+
+// The vector kernels round with a single add and shift: for negative f, (f - 0.5) >> 8 is one
+// less than (f + 0.5) >> 8, because they differ by exactly 1.0, so adding 1 back makes the two
+// branches of the scalar kernel the same expression.
+
+#ifdef ANTARES_CARRY_X86
+
+void carry_sse2(
+        int32_t n, const Fixed* velocity, const Fixed* fraction, Fixed* out_fraction,
+        int32_t* whole) {
+    const __m128i half = _mm_set1_epi32(Fixed::from_float(0.5).val());
+    int32_t       i    = 0;
+    for (; (i + 4) <= n; i += 4) {
+        __m128i f = _mm_add_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(fraction + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(velocity + i)));
+        __m128i h = _mm_srai_epi32(_mm_add_epi32(f, half), 8);
+        _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(out_fraction + i),
+                _mm_sub_epi32(f, _mm_slli_epi32(h, 8)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(whole + i), h);
+    }
+    carry_scalar(n - i, velocity + i, fraction + i, out_fraction + i, whole + i);
+}
+
+__attribute__((target("avx2"))) void carry_avx2(
+        int32_t n, const Fixed* velocity, const Fixed* fraction, Fixed* out_fraction,
+        int32_t* whole) {
+    const __m256i half = _mm256_set1_epi32(Fixed::from_float(0.5).val());
+    int32_t       i    = 0;
+    for (; (i + 8) <= n; i += 8) {
+        __m256i f = _mm256_add_epi32(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(fraction + i)),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(velocity + i)));
+        __m256i h = _mm256_srai_epi32(_mm256_add_epi32(f, half), 8);
+        _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(out_fraction + i),
+                _mm256_sub_epi32(f, _mm256_slli_epi32(h, 8)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(whole + i), h);
+    }
+    carry_sse2(n - i, velocity + i, fraction + i, out_fraction + i, whole + i);
+}
+
+#endif  // ANTARES_CARRY_X86
+
+}  // namespace
+
+bool carry_kernel_supported(CarryKernel kernel) {
+    switch (kernel) {
+        case CarryKernel::SCALAR: return true;
+#ifdef ANTARES_CARRY_X86
+        case CarryKernel::SSE2: return __builtin_cpu_supports("sse2");
+        case CarryKernel::AVX2: return __builtin_cpu_supports("avx2");
+#else
+        case CarryKernel::SSE2: return false;
+        case CarryKernel::AVX2: return false;
+#endif
+    }
+    return false;
+}
+
+CarryKernel best_carry_kernel() {
+    for (CarryKernel kernel : {CarryKernel::AVX2, CarryKernel::SSE2}) {
+        if (carry_kernel_supported(kernel)) {
+            return kernel;
+        }
+    }
+    return CarryKernel::SCALAR;
+}
+
+void carry_fractions(
+        CarryKernel kernel, int32_t n, const Fixed* velocity, const Fixed* fraction,
+        Fixed* out_fraction, int32_t* whole) {
+    static_assert(sizeof(Fixed) == sizeof(int32_t), "Fixed must be a bare int32_t");
+    switch (kernel) {
+        case CarryKernel::SCALAR:
+            carry_scalar(n, velocity, fraction, out_fraction, whole);
+            return;
+#ifdef ANTARES_CARRY_X86
+        case CarryKernel::SSE2: carry_sse2(n, velocity, fraction, out_fraction, whole); return;
+        case CarryKernel::AVX2: carry_avx2(n, velocity, fraction, out_fraction, whole); return;
+#else
+        case CarryKernel::SSE2:
+        case CarryKernel::AVX2: break;
+#endif
+    }
+    throw std::runtime_error("unsupported carry kernel");
+}
+
+void carry_fractions(
+        int32_t n, const Fixed* velocity, const Fixed* fraction, Fixed* out_fraction,
+        int32_t* whole) {
+    static const CarryKernel kernel = best_carry_kernel();
+    carry_fractions(kernel, n, velocity, fraction, out_fraction, whole);
+}
+
+}  // namespace antares
@@ -0,0 +1,112 @@
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "math/kinematics.hpp"
+
+#include <gmock/gmock.h>
+#include <vector>
+
+using testing::ElementsAreArray;
+using testing::Eq;
+
+namespace antares {
+namespace {
+
+using KinematicsTest = testing::Test;
+
+struct Carried {
+    std::vector<Fixed>   fraction;
+    std::vector<int32_t> whole;
+};
+
+Carried carry(
+        CarryKernel kernel, const std::vector<Fixed>& velocity,
+        const std::vector<Fixed>& fraction) {
+    Carried result{std::vector<Fixed>(fraction.size()), std::vector<int32_t>(fraction.size())};
+    carry_fractions(
+            kernel, fraction.size(), velocity.data(), fraction.data(), result.fraction.data(),
+            result.whole.data());
+    return result;
+}
+
+void expect_kernels_match(const std::vector<Fixed>& velocity, const std::vector<Fixed>& fraction) {
+    Carried expected = carry(CarryKernel::SCALAR, velocity, fraction);
+    for (CarryKernel kernel : {CarryKernel::SSE2, CarryKernel::AVX2}) {
+        if (!carry_kernel_supported(kernel)) {
+            continue;
+        }
+        Carried actual = carry(kernel, velocity, fraction);
+        EXPECT_THAT(actual.fraction, ElementsAreArray(expected.fraction));
+        EXPECT_THAT(actual.whole, ElementsAreArray(expected.whole));
+    }
+}
+
+TEST_F(KinematicsTest, Scalar) {
+    std::vector<Fixed> velocity = {
+            Fixed::from_val(0),   Fixed::from_val(128),  Fixed::from_val(-128),
+            Fixed::from_val(129), Fixed::from_val(-129), Fixed::from_val(384),
+            Fixed::from_val(-384)};
+    std::vector<Fixed> fraction(velocity.size(), Fixed::zero());
+    Carried            carried = carry(CarryKernel::SCALAR, velocity, fraction);
+    EXPECT_THAT(carried.whole, ElementsAreArray({0, 1, 0, 1, -1, 2, -1}));
+    EXPECT_THAT(
+            carried.fraction,
+            ElementsAreArray(
+                    {Fixed::from_val(0), Fixed::from_val(-128), Fixed::from_val(-128),
+                     Fixed::from_val(-127), Fixed::from_val(127), Fixed::from_val(-128),
+                     Fixed::from_val(-128)}));
+}
+
+// Every length up to a few vectors wide, so that each kernel’s scalar tail gets exercised.
+TEST_F(KinematicsTest, Randomized) {
+    uint32_t seed = 1;
+    auto     next = [&seed] {
+        seed = (seed * 1103515245) + 12345;
+        return static_cast<int32_t>(seed >> 7) - (1 << 24);
+    };
+    for (int n = 0; n < 40; ++n) {
+        for (int i = 0; i < 50; ++i) {
+            std::vector<Fixed> velocity, fraction;
+            for (int j = 0; j < n; ++j) {
+                velocity.push_back(Fixed::from_val(next()));
+                fraction.push_back(Fixed::from_val(next()));
+            }
+            expect_kernels_match(velocity, fraction);
+        }
+    }
+}
+
+TEST_F(KinematicsTest, One) {
+    Fixed fraction = Fixed::from_val(100);
+    EXPECT_THAT(carry_fraction(Fixed::from_val(200), &fraction), Eq(1));
+    EXPECT_THAT(fraction, Eq(Fixed::from_val(44)));
+    fraction = Fixed::from_val(-100);
+    EXPECT_THAT(carry_fraction(Fixed::from_val(-200), &fraction), Eq(-1));
+    EXPECT_THAT(fraction, Eq(Fixed::from_val(-44)));
+}
+
+TEST_F(KinematicsTest, InPlace) {
+    std::vector<Fixed> velocity = {Fixed::from_val(200), Fixed::from_val(-200)};
+    std::vector<Fixed> fraction = {Fixed::from_val(100), Fixed::from_val(-100)};
+    int32_t            whole[2];
+    carry_fractions(2, velocity.data(), fraction.data(), fraction.data(), whole);
+    EXPECT_THAT(whole, ElementsAreArray({1, -1}));
+    EXPECT_THAT(fraction, ElementsAreArray({Fixed::from_val(44), Fixed::from_val(-44)}));
+}
+
+}  // namespace
+}  // namespace antares
@@ -56,6 +56,30 @@ void EventScheduler::schedule_snapshot(int64_t at) {
     push_heap(_snapshot_times.begin(), _snapshot_times.end(), greater<wall_ticks>());
 }
 
+void EventScheduler::schedule_snapshots(int64_t start, int64_t stride) {
+    schedule_snapshots(start, stride, wall_ticks::max().time_since_epoch().count());
+}
+
+void EventScheduler::schedule_snapshots(int64_t start, int64_t stride, int64_t end) {
+    if (stride <= 0) {
+        throw std::runtime_error("snapshot stride must be positive");
+    }
+    if (start < end) {
+        _snapshot_recurrences.push_back(
+                Recurrence{wall_ticks(ticks(start)), ticks(stride), wall_ticks(ticks(end))});
+    }
+}
+
+void EventScheduler::snapshot_on(SnapshotTrigger trigger) {
+    _snapshot_triggers |= 1u << static_cast<int>(trigger);
+}
+
+void EventScheduler::trigger_snapshot(SnapshotTrigger trigger) {
+    if (_snapshot_triggers & (1u << static_cast<int>(trigger))) {
+        _triggered = true;
+    }
+}
+
 void EventScheduler::schedule_event(unique_ptr<Event> event) {
     _event_heap.emplace_back(std::move(event));
     push_heap(_event_heap.begin(), _event_heap.end(), is_later);
@@ -97,20 +121,66 @@ void EventScheduler::loop(EventScheduler::MainLoop& loop) {
 }
 
 void EventScheduler::advance_tick_count(EventScheduler::MainLoop& loop, wall_ticks ticks) {
-    if (loop.takes_snapshots() && have_snapshots_before(ticks)) {
+    if (!loop.takes_snapshots()) {
+        _triggered = false;
+        _ticks     = ticks;
+        return;
+    }
+
+    // A triggered snapshot shows the state just after the tick in which the trigger happened.
+    bool drawn = false;
+    if (_triggered) {
+        _triggered = false;
         loop.draw();
-        while (have_snapshots_before(ticks)) {
-            _ticks = _snapshot_times.front();
-            loop.snapshot(_ticks);
-            pop_heap(_snapshot_times.begin(), _snapshot_times.end(), greater<wall_ticks>());
-            _snapshot_times.pop_back();
+        drawn = true;
+        loop.snapshot(_ticks);
+    }
+
+    wall_ticks at;
+    while (next_snapshot(&at) && (at < ticks)) {
+        if (!drawn) {
+            loop.draw();
+            drawn = true;
         }
+        _ticks = at;
+        loop.snapshot(_ticks);
+        pop_snapshot(at);
     }
     _ticks = ticks;
 }
 
-bool EventScheduler::have_snapshots_before(wall_ticks ticks) const {
-    return !_snapshot_times.empty() && (_snapshot_times.front() < ticks);
+bool EventScheduler::next_snapshot(wall_ticks* at) const {
+    bool found = false;
+    if (!_snapshot_times.empty()) {
+        *at   = _snapshot_times.front();
+        found = true;
+    }
+    for (const Recurrence& r : _snapshot_recurrences) {
+        if (!found || (r.next < *at)) {
+            *at   = r.next;
+            found = true;
+        }
+    }
+    return found;
+}
+
+// Removes or advances every schedule that would take a snapshot at `at`, so that two schedules
+// that coincide only take one.
+void EventScheduler::pop_snapshot(wall_ticks at) {
+    while (!_snapshot_times.empty() && (_snapshot_times.front() == at)) {
+        pop_heap(_snapshot_times.begin(), _snapshot_times.end(), greater<wall_ticks>());
+        _snapshot_times.pop_back();
+    }
+    for (auto it = _snapshot_recurrences.begin(); it != _snapshot_recurrences.end();) {
+        if (it->next == at) {
+            it->next += it->stride;
+        }
+        if (it->next >= it->end) {
+            it = _snapshot_recurrences.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 bool EventScheduler::is_later(const unique_ptr<Event>& x, const unique_ptr<Event>& y) {
@@ -89,7 +89,9 @@ int score_high_target(double yours, double par, double value) {
     }
 }
 
-int score(
+}  // namespace
+
+int DebriefingScreen::score(
         game_ticks your_length, game_ticks par_length, int your_loss, int par_loss, int your_kill,
         int par_kill) {
     int score = 0;
@@ -101,8 +103,6 @@ int score(
     return score;
 }
 
-}  // namespace
-
 DebriefingScreen::DebriefingScreen(pn::string_view message)
         : _state(DONE), _data_item(initialize(message, false)) {}
 
@@ -18,11 +18,79 @@
 
 #include "video/driver.hpp"
 
+#include <map>
+
+#include "drawing/pix-map.hpp"
 #include "game/sys.hpp"
 #include "lang/defines.hpp"
 
 namespace antares {
 
+namespace {
+
+// Keeps a plain texture for ordinary drawing, and makes one more for each hue it's drawn in.
+class HuedTextureImpl : public Texture::Impl {
+  public:
+    HuedTextureImpl(
+            VideoDriver& driver, pn::string_view name, const PixMap& content,
+            const PixMap& overlay, int scale)
+            : _driver(driver),
+              _name(name.copy()),
+              _content(content.size()),
+              _overlay(overlay.size()),
+              _scale(scale) {
+        _content.copy(content);
+        _overlay.copy(overlay);
+        _plain = _driver.texture(_name, _content, _scale);
+    }
+
+    virtual pn::string_view name() const { return _name; }
+    virtual void draw(const Rect& draw_rect) const { _plain.draw(draw_rect); }
+    virtual void draw_cropped(const Rect& dest, const Rect& source, const RgbColor& tint) const {
+        Quads(_plain).draw(dest, source, tint);
+    }
+    virtual void draw_shaded(const Rect& draw_rect, const RgbColor& tint) const {
+        _plain.draw_shaded(draw_rect, tint);
+    }
+    virtual void draw_static(const Rect& draw_rect, const RgbColor& color, uint8_t frac) const {
+        _plain.draw_static(draw_rect, color, frac);
+    }
+    virtual void draw_outlined(
+            const Rect& draw_rect, const RgbColor& outline_color,
+            const RgbColor& fill_color) const {
+        _plain.draw_outlined(draw_rect, outline_color, fill_color);
+    }
+    virtual const Size& size() const { return _plain.size(); }
+
+    virtual void draw_hued_quad(
+            const Rect& dest, const Rect& source, Hue hue, pn::string_view frame) const {
+        if (hue == Hue::GRAY) {
+            Quads(_plain).draw(dest, source, hue, frame);
+            return;
+        }
+        auto it = _hued.find(hue);
+        if (it == _hued.end()) {
+            ArrayPixMap pix(_content.size());
+            pix.copy(_content);
+            pix.tint_overlay(_overlay, hue);
+            pn::string name = pn::format("{0}#{1}", _name, static_cast<int>(hue));
+            it              = _hued.emplace(hue, _driver.texture(name, pix, _scale)).first;
+        }
+        Quads(it->second).draw(dest, source, Hue::GRAY, frame);
+    }
+
+  private:
+    VideoDriver&                   _driver;
+    const pn::string               _name;
+    ArrayPixMap                    _content;
+    ArrayPixMap                    _overlay;
+    const int                      _scale;
+    Texture                        _plain;
+    mutable std::map<Hue, Texture> _hued;
+};
+
+}  // namespace
+
 VideoDriver::VideoDriver() {
     if (sys.video) {
         throw std::runtime_error("VideoDriver is a singleton");
@@ -32,6 +100,12 @@ VideoDriver::VideoDriver() {
 
 VideoDriver::~VideoDriver() { sys.video = NULL; }
 
+Texture VideoDriver::hued_texture(
+        pn::string_view name, const PixMap& content, const PixMap& overlay, int scale) {
+    return std::unique_ptr<Texture::Impl>(
+            new HuedTextureImpl(*this, name, content, overlay, scale));
+}
+
 Texture::Impl::~Impl() {}
 
 TextReceiver::~TextReceiver() { sys.video->stop_editing(this); }
@@ -68,4 +142,8 @@ void Quads::draw(const Rect& dest, const Rect& source, const RgbColor& tint) con
     _sprite._impl->draw_quad(dest, source, tint);
 }
 
+void Quads::draw(const Rect& dest, const Rect& source, Hue hue, pn::string_view frame) const {
+    _sprite._impl->draw_hued_quad(dest, source, hue, frame);
+}
+
 }  // namespace antares
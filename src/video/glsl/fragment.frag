@@ -18,9 +18,10 @@
 
 #version 330 core
 
-in vec2 uv;
-in vec4 color;
-in vec2 screen_position;
+in vec2     uv;
+in vec4     color;
+in vec2     screen_position;
+flat in int hue;
 
 out vec4 frag_color;
 
@@ -32,6 +33,8 @@ uniform float     static_fraction;
 uniform vec2 unit;
 uniform vec4 outline_color;
 uniform int  seed;
+uniform sampler2DRect overlay;
+uniform sampler2D     tints;
 
 const int FILL_MODE           = 0;
 const int DITHER_MODE         = 1;
@@ -40,6 +43,16 @@ const int TINT_SPRITE_MODE    = 3;
 const int STATIC_SPRITE_MODE  = 4;
 const int OUTLINE_SPRITE_MODE = 5;
 
+// Blends in the overlay, tinted with the hue, as PixMap::tint_overlay() does on the CPU.
+vec4 tint_overlay(vec4 under) {
+    if (hue == 0) {
+        return under;
+    }
+    vec4 over  = texture(overlay, uv);
+    vec4 shade = texelFetch(tints, ivec2(int(over.r * 255.0 + 0.5), hue), 0);
+    return vec4(mix(under.rgb, shade.rgb, over.a), under.a);
+}
+
 void main() {
     vec4 sprite_color = texture(sprite, uv);
     if (color_mode == FILL_MODE) {
@@ -50,7 +63,7 @@ void main() {
     } else if (color_mode == DRAW_SPRITE_MODE) {
         frag_color = sprite_color;
     } else if (color_mode == TINT_SPRITE_MODE) {
-        frag_color = color * sprite_color;
+        frag_color = color * tint_overlay(sprite_color);
     } else if (color_mode == STATIC_SPRITE_MODE) {
         float f            = scale / 256.0;
         vec2  uv2          = (screen_position + vec2(seed * f, seed)) * vec2(f, f);
@@ -21,10 +21,12 @@
 in vec2 vertex;
 in vec4 in_color;
 in vec2 tex_coord;
+in float in_hue;
 
-out vec2 uv;
-out vec4 color;
-out vec2 screen_position;
+out vec2     uv;
+out vec4     color;
+out vec2     screen_position;
+flat out int hue;
 
 uniform vec2 screen;
 
@@ -36,4 +38,5 @@ void main() {
     uv              = tex_coord;
     screen_position = vertex;
     color           = in_color;
+    hue             = int(in_hue);
 }
@@ -0,0 +1,77 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "video/null-driver.hpp"
+
+#include "data/plugin.hpp"
+#include "drawing/pix-map.hpp"
+#include "drawing/sprite-handling.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/instruments.hpp"
+#include "game/labels.hpp"
+#include "game/messages.hpp"
+#include "game/space-object.hpp"
+#include "game/sys.hpp"
+#include "game/vector.hpp"
+#include "sound/driver.hpp"
+
+namespace antares {
+
+class NullVideoDriver::TextureImpl : public Texture::Impl {
+  public:
+    TextureImpl(pn::string_view name, Size size) : _name(name.copy()), _size(size) {}
+
+    virtual pn::string_view name() const { return _name; }
+    virtual void            draw(const Rect& draw_rect) const {}
+    virtual void draw_cropped(const Rect& dest, const Rect& source, const RgbColor& tint) const {}
+    virtual void draw_shaded(const Rect& draw_rect, const RgbColor& tint) const {}
+    virtual void draw_static(const Rect& draw_rect, const RgbColor& color, uint8_t frac) const {}
+    virtual void draw_outlined(
+            const Rect& draw_rect, const RgbColor& outline_color,
+            const RgbColor& fill_color) const {}
+    virtual const Size& size() const { return _size; }
+
+  private:
+    pn::string _name;
+    Size       _size;
+};
+
+wall_time NullVideoDriver::now() const { return wall_time(g.time.time_since_epoch()); }
+
+Texture NullVideoDriver::texture(pn::string_view name, const PixMap& content, int scale) {
+    return std::unique_ptr<Texture::Impl>(new TextureImpl(name, content.size()));
+}
+
+void init_headless_game() {
+    init_globals();
+
+    sys.audio->set_global_volume(8);  // Max volume.
+
+    sys_init();
+    Label::init();
+    Messages::init();
+    InstrumentInit();
+    SpriteHandlingInit();
+    PluginInit();
+    SpaceObjectHandlingInit();  // MUST be after PluginInit()
+    Admiral::init();
+    Vectors::init();
+}
+
+}  // namespace antares
@@ -20,8 +20,10 @@
 
 #include <fcntl.h>
 #include <stdlib.h>
+#include <string.h>
 #include <strings.h>
 #include <algorithm>
+#include <functional>
 #include <pn/output>
 #include <sfz/sfz.hpp>
 
@@ -59,38 +61,108 @@ namespace antares {
 
 namespace {
 
+void gl_check() {
+    GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+        throw std::runtime_error(pn::format("gl: {0}", error).c_str());
+    }
+}
+
+// RgbColor is stored as alpha, red, green, blue. Reading back BGRA as a packed integer, with blue
+// in the high byte, puts the bytes in that order in memory.
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+const GLenum kArgbType = GL_UNSIGNED_INT_8_8_8_8_REV;
+#else
+const GLenum kArgbType = GL_UNSIGNED_INT_8_8_8_8;
+#endif
+
+// Reads snapshots back from the framebuffer through a pair of pixel buffers.
+//
+// `read()` only queues the transfer, and returns before it is done; the previous snapshot is
+// mapped and handed to the callback instead, by which time its transfer has usually finished.
+// The last snapshot is delivered by `finish()`.
 class SnapshotBuffer {
   public:
-    SnapshotBuffer() {}
+    typedef std::function<void(const PixMap& pix, pn::string_view name)> Callback;
 
-    void copy(Rect bounds, ArrayPixMap& pix) {
-        _data.resize(bounds.area() * 4);
-        Size size = bounds.size();
+    SnapshotBuffer(Callback callback) : _callback(callback) {
+        glGenBuffers(2, _pbo);
+        gl_check();
+    }
+    SnapshotBuffer(const SnapshotBuffer&) = delete;
+    SnapshotBuffer& operator=(const SnapshotBuffer&) = delete;
+    ~SnapshotBuffer() { glDeleteBuffers(2, _pbo); }
+
+    void read(Rect bounds, pn::string_view name) {
+        // Blending can leave the alpha channel less than opaque. Clear it on the GPU, so that
+        // rows can be copied out of the pixel buffer as they are.
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_TRUE);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbo[_next]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, bounds.area() * 4, nullptr, GL_STREAM_READ);
         glReadPixels(
-                bounds.left, bounds.top, size.width, size.height, GL_BGRA, GL_UNSIGNED_BYTE,
-                _data.data());
-        uint8_t* p = _data.data();
-        for (int32_t y : range(size.height)) {
-            for (int32_t x : range(size.width)) {
-                uint8_t blue  = *(p++);
-                uint8_t green = *(p++);
-                uint8_t red   = *(p++);
-                ++p;
-                pix.set(x, size.height - y - 1, rgb(red, green, blue));
+                bounds.left, bounds.top, bounds.width(), bounds.height(), GL_BGRA, kArgbType,
+                nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        Pending& p = _pending[_next];
+        p.active   = true;
+        p.size     = bounds.size();
+        p.name     = name.copy();
+
+        _next = 1 - _next;
+        if (_pending[_next].active) {
+            deliver(_pending[_next]);
+        }
+    }
+
+    void finish() {
+        for (int i : range(2)) {
+            Pending& p = _pending[(_next + i) % 2];
+            if (p.active) {
+                deliver(p);
             }
         }
     }
 
   private:
-    vector<uint8_t> _data;
-};
+    struct Pending {
+        bool       active = false;
+        Size       size;
+        pn::string name;
+    };
 
-void gl_check() {
-    GLenum error = glGetError();
-    if (error != GL_NO_ERROR) {
-        throw std::runtime_error(pn::format("gl: {0}", error).c_str());
+    // Maps the pixel buffer, and copies it out a row at a time. GL puts the bottom row first.
+    void deliver(Pending& p) {
+        GLuint pbo = _pbo[&p - _pending];
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        const uint8_t* data =
+                reinterpret_cast<const uint8_t*>(glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
+        if (!data) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            throw std::runtime_error("couldn't map pixel buffer");
+        }
+        if (_pix.size() != p.size) {
+            _pix.resize(p.size);
+        }
+        const size_t row_size = p.size.width * sizeof(RgbColor);
+        for (int32_t y : range(p.size.height)) {
+            memcpy(_pix.mutable_row(p.size.height - y - 1), data + (y * row_size), row_size);
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        p.active = false;
+        _callback(_pix, p.name);
     }
-}
+
+    const Callback _callback;
+    GLuint         _pbo[2];
+    Pending        _pending[2];
+    int            _next = 0;
+    ArrayPixMap    _pix{0, 0};
+};
 
 struct Framebuffer {
     GLuint id;
@@ -116,6 +188,72 @@ struct Renderbuffer {
 
 }  // namespace
 
+class OffscreenVideoDriver::FrameWriter {
+  public:
+    FrameWriter(pn::output_view out, FrameFormat format, int32_t ticks_per_frame)
+            : _out(out), _format(format), _ticks_per_frame(ticks_per_frame) {}
+
+    void write(const PixMap& pix) {
+        switch (_format) {
+            case FrameFormat::Y4M: write_y4m(pix); break;
+            case FrameFormat::RGBA: write_rgba(pix); break;
+        }
+    }
+
+  private:
+    void write_y4m(const PixMap& pix) {
+        const Size size = pix.size();
+        if (!_size.has_value()) {
+            _size.emplace(size);
+            _out.format(
+                    "YUV4MPEG2 W{0} H{1} F60:{2} Ip A1:1 C444\n", size.width, size.height,
+                    _ticks_per_frame);
+        } else if (*_size != size) {
+            throw std::runtime_error("frame size changed");
+        }
+
+        // BT.601, limited range; one plane each of Y, U, and V.
+        const int32_t plane = size.width * size.height;
+        _data.resize(plane * 3);
+        uint8_t* y_out = _data.data();
+        uint8_t* u_out = y_out + plane;
+        uint8_t* v_out = u_out + plane;
+        for (int32_t y : range(size.height)) {
+            for (const RgbColor* c : range(pix.row(y), pix.row(y) + size.width)) {
+                const int r = c->red;
+                const int g = c->green;
+                const int b = c->blue;
+                *(y_out++)  = ((66 * r + 129 * g + 25 * b + 128) >> 8) + 16;
+                *(u_out++)  = ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128;
+                *(v_out++)  = ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128;
+            }
+        }
+        _out.write("FRAME\n");
+        _out.write(pn::data_view{_data.data(), static_cast<int>(_data.size())});
+    }
+
+    void write_rgba(const PixMap& pix) {
+        const Size size = pix.size();
+        _data.resize(size.width * 4);
+        for (int32_t y : range(size.height)) {
+            uint8_t* p = _data.data();
+            for (const RgbColor* c : range(pix.row(y), pix.row(y) + size.width)) {
+                *(p++) = c->red;
+                *(p++) = c->green;
+                *(p++) = c->blue;
+                *(p++) = c->alpha;
+            }
+            _out.write(pn::data_view{_data.data(), static_cast<int>(_data.size())});
+        }
+    }
+
+    pn::output_view     _out;
+    const FrameFormat   _format;
+    const int32_t       _ticks_per_frame;
+    sfz::optional<Size> _size;
+    vector<uint8_t>     _data;
+};
+
 class OffscreenVideoDriver::MainLoop : public EventScheduler::MainLoop {
   public:
     MainLoop(
@@ -123,6 +261,7 @@ class OffscreenVideoDriver::MainLoop : public EventScheduler::MainLoop {
             Card* initial)
             : _driver(driver),
               _offscreen(driver._screen_size),
+              _buffer([this](const PixMap& pix, pn::string_view name) { write(pix, name); }),
               _setup(*this),
               _loop(driver, initial) {
         if (output_dir.has_value()) {
@@ -130,7 +269,7 @@ class OffscreenVideoDriver::MainLoop : public EventScheduler::MainLoop {
         }
     }
 
-    bool takes_snapshots() { return _output_dir.has_value(); }
+    bool takes_snapshots() { return _output_dir.has_value() || _driver._frames; }
 
     void snapshot(wall_ticks ticks) {
         snapshot_to(
@@ -143,19 +282,35 @@ class OffscreenVideoDriver::MainLoop : public EventScheduler::MainLoop {
             return;
         }
         bounds.offset(0, _driver._screen_size.height - bounds.height() - bounds.top);
-        ArrayPixMap pix(bounds.size());
-        _buffer.copy(bounds, pix);
-        pn::string path = pn::format("{0}/{1}", *_output_dir, relpath);
-        sfz::makedirs(path::dirname(path), 0755);
-        pn::output out{path, pn::binary};
-        pix.encode(out);
+        _buffer.read(bounds, relpath);
+    }
+
+    // Writes out any snapshots still being read back.
+    void finish() { _buffer.finish(); }
+
+    void draw() {
+        _loop.draw();
+        if (_driver._print_draw_calls) {
+            const auto& stats = _driver.frame_stats();
+            pn::out.format("{0} {1}\n", stats.draw_calls, stats.bytes_uploaded);
+        }
     }
 
-    void  draw() { _loop.draw(); }
     bool  done() const { return _loop.done(); }
     Card* top() const { return _loop.top(); }
 
   private:
+    void write(const PixMap& pix, pn::string_view relpath) {
+        if (_driver._frames) {
+            _driver._frames->write(pix);
+            return;
+        }
+        pn::string path = pn::format("{0}/{1}", *_output_dir, relpath);
+        sfz::makedirs(path::dirname(path), 0755);
+        pn::output out{path, pn::binary};
+        pix.encode(out);
+    }
+
     const OffscreenVideoDriver& _driver;
     Offscreen                   _offscreen;
     Framebuffer                 _fb;
@@ -185,6 +340,13 @@ OffscreenVideoDriver::OffscreenVideoDriver(
     }
 }
 
+OffscreenVideoDriver::~OffscreenVideoDriver() {}
+
+void OffscreenVideoDriver::set_frame_output(
+        pn::output_view out, FrameFormat format, int32_t ticks_per_frame) {
+    _frames.reset(new FrameWriter(out, format, ticks_per_frame));
+}
+
 bool OffscreenVideoDriver::start_editing(TextReceiver* text) { return false; }
 
 void OffscreenVideoDriver::stop_editing(TextReceiver* text) {}
@@ -193,6 +355,7 @@ void OffscreenVideoDriver::loop(Card* initial, EventScheduler& scheduler) {
     _scheduler = &scheduler;
     MainLoop loop(*this, _output_dir, initial);
     _scheduler->loop(loop);
+    loop.finish();
     _scheduler = nullptr;
 }
 
@@ -221,6 +384,7 @@ void OffscreenVideoDriver::capture(vector<pair<unique_ptr<Card>, pn::string>>& p
         loop.snapshot_to(_capture_rect, p.second);
         loop.top()->stack()->pop(loop.top());
     }
+    loop.finish();
 }
 
 }  // namespace antares
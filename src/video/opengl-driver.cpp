@@ -18,13 +18,16 @@
 
 #include "video/opengl-driver.hpp"
 
+#include <stddef.h>
 #include <stdint.h>
 #include <algorithm>
 #include <pn/output>
+#include <vector>
 
 #include "drawing/color.hpp"
 #include "drawing/pix-map.hpp"
 #include "drawing/shapes.hpp"
+#include "drawing/styled-text.hpp"
 #include "game/globals.hpp"
 #include "math/geometry.hpp"
 #include "math/random.hpp"
@@ -86,6 +89,10 @@ enum {
     OUTLINE_SPRITE_MODE = 5,
 };
 
+// Size of the buffer that vertices are streamed through. A frame usually needs far less; when
+// it fills up, the buffer is orphaned and streaming starts again at the beginning.
+const size_t kStreamBytes = 1 << 20;
+
 #ifndef NDEBUG
 
 static const char* _gl_error_string(GLenum err) {
@@ -159,6 +166,8 @@ static T _gl_check(T t, const char* fn, const char* file, int line) {
 #define glGenBuffers(n, buffers) _GL(glGenBuffers, n, buffers)
 #define glBindBuffer(target, buffer) _GL(glBindBuffer, target, buffer)
 #define glBufferData(target, size, data, usage) _GL(glBufferData, target, size, data, usage)
+#define glBufferSubData(target, offset, size, data) \
+    _GL(glBufferSubData, target, offset, size, data)
 #define glVertexAttribPointer(index, size, type, normalized, stride, pointer) \
     _GL(glVertexAttribPointer, index, size, type, normalized, stride, pointer)
 #define glEnableVertexAttribArray(index) _GL(glEnableVertexAttribArray, index)
@@ -188,41 +197,24 @@ void gl_log(GLint object) {
 class OpenGlTextureImpl : public Texture::Impl {
   public:
     OpenGlTextureImpl(
-            pn::string_view name, const PixMap& image, int scale,
-            const OpenGlVideoDriver::Uniforms& uniforms, GLuint vbuf[3])
+            pn::string_view name, const PixMap& image, const PixMap* overlay, int scale,
+            const OpenGlVideoDriver::Uniforms& uniforms, OpenGlVideoDriver::Stream& stream)
             : _name(name.copy()),
               _size(image.size()),
               _scale(scale),
               _uniforms(uniforms),
-              _vbuf(vbuf) {
-        glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
-        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-#if defined(__LITTLE_ENDIAN__)
-        GLenum type = GL_UNSIGNED_INT_8_8_8_8;
-#elif defined(__BIG_ENDIAN__)
-        GLenum type = GL_UNSIGNED_INT_8_8_8_8_REV;
-#else
-#error "Couldn't determine endianness of platform"
-#endif
-
-        // Add a 1-pixel clear border.  Color mode 5 (outline) won't work unless we do this.
-        Size size = image.size();
-        size.width += 2;
-        size.height += 2;
-        ArrayPixMap copy(size);
-        copy.fill(RgbColor::clear());
-        copy.view(Rect(1, 1, size.width - 1, size.height - 1)).copy(image);
-        glTexImage2D(
-                GL_TEXTURE_RECTANGLE, 0, GL_RGBA, size.width, size.height, 0, GL_BGRA, type,
-                copy.bytes());
+              _stream(stream) {
+        upload(_texture.id, image);
+        if (overlay) {
+            _overlay.reset(new Texture);
+            upload(_overlay->id, *overlay);
+        }
     }
 
     virtual pn::string_view name() const { return _name; }
 
     virtual void draw(const Rect& draw_rect) const {
+        _stream.flush();
         _uniforms.color_mode.set(DRAW_SPRITE_MODE);
         draw_internal(draw_rect, RgbColor::white());
     }
@@ -234,11 +226,13 @@ class OpenGlTextureImpl : public Texture::Impl {
     }
 
     virtual void draw_shaded(const Rect& draw_rect, const RgbColor& tint) const {
+        _stream.flush();
         _uniforms.color_mode.set(TINT_SPRITE_MODE);
         draw_internal(draw_rect, tint);
     }
 
     virtual void draw_static(const Rect& draw_rect, const RgbColor& color, uint8_t frac) const {
+        _stream.flush();
         _uniforms.color_mode.set(STATIC_SPRITE_MODE);
         _uniforms.static_fraction.set(frac / 255.0f);
         draw_internal(draw_rect, color);
@@ -247,6 +241,7 @@ class OpenGlTextureImpl : public Texture::Impl {
     virtual void draw_outlined(
             const Rect& draw_rect, const RgbColor& outline_color,
             const RgbColor& fill_color) const {
+        _stream.flush();
         _uniforms.color_mode.set(OUTLINE_SPRITE_MODE);
         _uniforms.unit.set({float(_size.width) / draw_rect.width(),
                             float(_size.height) / draw_rect.height()});
@@ -258,99 +253,82 @@ class OpenGlTextureImpl : public Texture::Impl {
     virtual const Size& size() const { return _size; }
 
   private:
-    virtual void draw_internal(const Rect& draw_rect, const RgbColor& tint) const {
-        glEnableVertexAttribArray(0);
-        glEnableVertexAttribArray(1);
-        glEnableVertexAttribArray(2);
-
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-        GLshort vertices[] = {
-                GLshort(draw_rect.left),   GLshort(draw_rect.top),   GLshort(draw_rect.left),
-                GLshort(draw_rect.bottom), GLshort(draw_rect.right), GLshort(draw_rect.bottom),
-                GLshort(draw_rect.right),  GLshort(draw_rect.top),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-        glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, 0, nullptr);
-
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-        GLubyte colors[] = {
-                tint.red,  tint.green, tint.blue, tint.alpha, tint.red,  tint.green,
-                tint.blue, tint.alpha, tint.red,  tint.green, tint.blue, tint.alpha,
-                tint.red,  tint.green, tint.blue, tint.alpha,
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
-
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[2]);
-        const int32_t w            = _size.width / _scale;
-        const int32_t h            = _size.height / _scale;
-        GLshort       tex_coords[] = {
-                GLshort(1),     GLshort(1),     GLshort(1),     GLshort(h + 1),
-                GLshort(w + 1), GLshort(h + 1), GLshort(w + 1), GLshort(1),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(tex_coords), tex_coords, GL_STREAM_DRAW);
-        glVertexAttribPointer(2, 2, GL_SHORT, GL_FALSE, 0, nullptr);
+    static void upload(GLuint id, const PixMap& image) {
+        glBindTexture(GL_TEXTURE_RECTANGLE, id);
+        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+#if defined(__LITTLE_ENDIAN__)
+        GLenum type = GL_UNSIGNED_INT_8_8_8_8;
+#elif defined(__BIG_ENDIAN__)
+        GLenum type = GL_UNSIGNED_INT_8_8_8_8_REV;
+#else
+#error "Couldn't determine endianness of platform"
+#endif
+
+        // Add a 1-pixel clear border.  Color mode 5 (outline) won't work unless we do this.
+        Size size = image.size();
+        size.width += 2;
+        size.height += 2;
+        ArrayPixMap copy(size);
+        copy.fill(RgbColor::clear());
+        copy.view(Rect(1, 1, size.width - 1, size.height - 1)).copy(image);
+        glTexImage2D(
+                GL_TEXTURE_RECTANGLE, 0, GL_RGBA, size.width, size.height, 0, GL_BGRA, type,
+                copy.bytes());
+    }
 
+    void bind() const {
+        if (_overlay) {
+            glActiveTexture(GL_TEXTURE2);
+            glBindTexture(GL_TEXTURE_RECTANGLE, _overlay->id);
+        }
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    }
 
-        glDisableVertexAttribArray(2);
-        glDisableVertexAttribArray(1);
-        glDisableVertexAttribArray(0);
+    // Draws the whole texture, in whatever mode the caller chose.
+    void draw_internal(const Rect& draw_rect, const RgbColor& tint) const {
+        bind();
+        _stream.begin(GL_TRIANGLES);
+        add_quad(draw_rect, Rect{0, 0, _size.width / _scale, _size.height / _scale}, tint,
+                 Hue::GRAY);
+        _stream.flush();
     }
 
     virtual void begin_quads() const {
+        _stream.flush();
         _uniforms.color_mode.set(TINT_SPRITE_MODE);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
+        bind();
+        _stream.begin(GL_TRIANGLES);
     }
 
-    virtual void end_quads() const {}
+    virtual void end_quads() const { _stream.flush(); }
 
     virtual void draw_quad(const Rect& dest, const Rect& source, const RgbColor& tint) const {
-        glEnableVertexAttribArray(0);
-        glEnableVertexAttribArray(1);
-        glEnableVertexAttribArray(2);
-
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-        GLshort vertices[] = {
-                GLshort(dest.left),   GLshort(dest.top),   GLshort(dest.left),
-                GLshort(dest.bottom), GLshort(dest.right), GLshort(dest.bottom),
-                GLshort(dest.right),  GLshort(dest.top),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-        glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, 0, nullptr);
-
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-        GLubyte colors[] = {
-                tint.red,  tint.green, tint.blue, tint.alpha, tint.red,  tint.green,
-                tint.blue, tint.alpha, tint.red,  tint.green, tint.blue, tint.alpha,
-                tint.red,  tint.green, tint.blue, tint.alpha,
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
+        add_quad(dest, source, tint, Hue::GRAY);
+    }
+
+    virtual void draw_hued_quad(
+            const Rect& dest, const Rect& source, Hue hue, pn::string_view frame) const {
+        add_quad(dest, source, RgbColor::white(), _overlay ? hue : Hue::GRAY);
+    }
 
+    // Adds two triangles: top-left, bottom-left, bottom-right; and top-left, bottom-right,
+    // top-right.
+    void add_quad(const Rect& dest, const Rect& source, const RgbColor& tint, Hue hue) const {
         Rect texture_rect = source;
         texture_rect.scale(_scale, _scale);
         texture_rect.offset(1, 1);
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[2]);
-        GLshort tex_coords[] = {
-                GLshort(texture_rect.left),  GLshort(texture_rect.top),
-                GLshort(texture_rect.left),  GLshort(texture_rect.bottom),
-                GLshort(texture_rect.right), GLshort(texture_rect.bottom),
-                GLshort(texture_rect.right), GLshort(texture_rect.top),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(tex_coords), tex_coords, GL_STREAM_DRAW);
-        glVertexAttribPointer(2, 2, GL_SHORT, GL_FALSE, 0, nullptr);
-
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-
-        glDisableVertexAttribArray(2);
-        glDisableVertexAttribArray(1);
-        glDisableVertexAttribArray(0);
+        const uint8_t h = static_cast<int>(hue);
+
+        _stream.add(dest.left, dest.top, tint, texture_rect.left, texture_rect.top, h);
+        _stream.add(dest.left, dest.bottom, tint, texture_rect.left, texture_rect.bottom, h);
+        _stream.add(dest.right, dest.bottom, tint, texture_rect.right, texture_rect.bottom, h);
+        _stream.add(dest.left, dest.top, tint, texture_rect.left, texture_rect.top, h);
+        _stream.add(dest.right, dest.bottom, tint, texture_rect.right, texture_rect.bottom, h);
+        _stream.add(dest.right, dest.top, tint, texture_rect.right, texture_rect.top, h);
     }
 
     struct Texture {
@@ -364,86 +342,124 @@ class OpenGlTextureImpl : public Texture::Impl {
 
     const pn::string                   _name;
     Texture                            _texture;
+    unique_ptr<Texture>                _overlay;
     Size                               _size;
     int                                _scale;
     const OpenGlVideoDriver::Uniforms& _uniforms;
-    GLuint*                            _vbuf;
+    OpenGlVideoDriver::Stream&         _stream;
 };
 
 }  // namespace
 
+void OpenGlVideoDriver::Stream::init() {
+    glGenBuffers(1, &_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+    _capacity = 0;
+    _offset   = 0;
+    _vertices.clear();
+
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(
+            0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+            reinterpret_cast<void*>(offsetof(Vertex, x)));
+    glVertexAttribPointer(
+            1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex),
+            reinterpret_cast<void*>(offsetof(Vertex, color)));
+    glVertexAttribPointer(
+            2, 2, GL_SHORT, GL_FALSE, sizeof(Vertex),
+            reinterpret_cast<void*>(offsetof(Vertex, u)));
+    glVertexAttribPointer(
+            3, 1, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(Vertex),
+            reinterpret_cast<void*>(offsetof(Vertex, hue)));
+}
+
+void OpenGlVideoDriver::Stream::begin(uint32_t mode) {
+    flush();
+    _mode = mode;
+}
+
+void OpenGlVideoDriver::Stream::add(
+        float x, float y, const RgbColor& color, int16_t u, int16_t v, uint8_t hue) {
+    _vertices.push_back(
+            Vertex{x, y, {color.red, color.green, color.blue, color.alpha}, u, v, hue});
+}
+
+void OpenGlVideoDriver::Stream::flush() {
+    if (_vertices.empty()) {
+        return;
+    }
+
+    const size_t bytes = _vertices.size() * sizeof(Vertex);
+    glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+    if ((_offset + bytes) > _capacity) {
+        // Orphan the buffer, rather than overwriting it. The driver can keep the old storage
+        // around until draws from it are done, so this never has to wait for the GPU.
+        _capacity = max(kStreamBytes, bytes);
+        _offset   = 0;
+        glBufferData(GL_ARRAY_BUFFER, _capacity, nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, _offset, bytes, _vertices.data());
+    glDrawArrays(_mode, _offset / sizeof(Vertex), _vertices.size());
+    _offset += bytes;
+
+    ++stats.draw_calls;
+    stats.bytes_uploaded += bytes;
+    _vertices.clear();
+}
+
 OpenGlVideoDriver::OpenGlVideoDriver() : _static_seed{0} {}
 
 int OpenGlVideoDriver::scale() const { return viewport_size().width / screen_size().width; }
 
 Texture OpenGlVideoDriver::texture(pn::string_view name, const PixMap& content, int scale) {
     return unique_ptr<Texture::Impl>(
-            new OpenGlTextureImpl(name, content, scale, _uniforms, _vbuf));
+            new OpenGlTextureImpl(name, content, nullptr, scale, _uniforms, _stream));
 }
 
-void OpenGlVideoDriver::begin_rects() { _uniforms.color_mode.set(FILL_MODE); }
-
-void OpenGlVideoDriver::batch_rect(const Rect& rect, const RgbColor& color) {
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-    GLshort vertices[] = {
-            GLshort(rect.right), GLshort(rect.top),    GLshort(rect.left),  GLshort(rect.top),
-            GLshort(rect.left),  GLshort(rect.bottom), GLshort(rect.right), GLshort(rect.bottom),
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-    glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, 0, nullptr);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-    GLubyte colors[] = {
-            color.red,  color.green, color.blue, color.alpha, color.red,  color.green,
-            color.blue, color.alpha, color.red,  color.green, color.blue, color.alpha,
-            color.red,  color.green, color.blue, color.alpha,
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
+Texture OpenGlVideoDriver::hued_texture(
+        pn::string_view name, const PixMap& content, const PixMap& overlay, int scale) {
+    return unique_ptr<Texture::Impl>(
+            new OpenGlTextureImpl(name, content, &overlay, scale, _uniforms, _stream));
+}
 
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+void OpenGlVideoDriver::begin_rects() {
+    _stream.flush();
+    _uniforms.color_mode.set(FILL_MODE);
+    _stream.begin(GL_TRIANGLES);
+}
 
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(0);
+void OpenGlVideoDriver::batch_rect(const Rect& rect, const RgbColor& color) {
+    _stream.add(rect.right, rect.top, color);
+    _stream.add(rect.left, rect.top, color);
+    _stream.add(rect.left, rect.bottom, color);
+    _stream.add(rect.right, rect.top, color);
+    _stream.add(rect.left, rect.bottom, color);
+    _stream.add(rect.right, rect.bottom, color);
 }
 
-void OpenGlVideoDriver::end_rects() {}
+void OpenGlVideoDriver::end_rects() { _stream.flush(); }
 
 void OpenGlVideoDriver::dither_rect(const Rect& rect, const RgbColor& color) {
+    _stream.flush();
     _uniforms.color_mode.set(DITHER_MODE);
+    _stream.begin(GL_TRIANGLES);
     batch_rect(rect, color);
+    _stream.flush();
 }
 
-void OpenGlVideoDriver::begin_points() { _uniforms.color_mode.set(FILL_MODE); }
+void OpenGlVideoDriver::begin_points() {
+    _stream.flush();
+    _uniforms.color_mode.set(FILL_MODE);
+    _stream.begin(GL_POINTS);
+}
 
-void OpenGlVideoDriver::end_points() {}
+void OpenGlVideoDriver::end_points() { _stream.flush(); }
 
 void OpenGlVideoDriver::batch_point(const Point& at, const RgbColor& color) {
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-    GLfloat vertices[] = {GLfloat(at.h + 0.5), GLfloat(at.v + 0.5)};
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-    GLubyte colors[] = {
-            color.red,
-            color.green,
-            color.blue,
-            color.alpha,
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
-
-    glDrawArrays(GL_POINTS, 0, 1);
-
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(0);
+    _stream.add(at.h + 0.5f, at.v + 0.5f, color);
 }
 
 void OpenGlVideoDriver::draw_point(const Point& at, const RgbColor& color) {
@@ -452,9 +468,13 @@ void OpenGlVideoDriver::draw_point(const Point& at, const RgbColor& color) {
     end_points();
 }
 
-void OpenGlVideoDriver::begin_lines() { _uniforms.color_mode.set(FILL_MODE); }
+void OpenGlVideoDriver::begin_lines() {
+    _stream.flush();
+    _uniforms.color_mode.set(FILL_MODE);
+    _stream.begin(GL_LINES);
+}
 
-void OpenGlVideoDriver::end_lines() {}
+void OpenGlVideoDriver::end_lines() { _stream.flush(); }
 
 void OpenGlVideoDriver::batch_line(const Point& from, const Point& to, const RgbColor& color) {
     //
@@ -489,26 +509,8 @@ void OpenGlVideoDriver::batch_line(const Point& from, const Point& to, const Rgb
         y2 += 1.0f;
     }
 
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-    GLfloat vertices[] = {x1, y1, x2, y2};
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-    GLubyte colors[] = {
-            color.red, color.green, color.blue, color.alpha,
-            color.red, color.green, color.blue, color.alpha,
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
-
-    glDrawArrays(GL_LINES, 0, 2);
-
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(0);
+    _stream.add(x1, y1, color);
+    _stream.add(x2, y2, color);
 }
 
 void OpenGlVideoDriver::draw_line(const Point& from, const Point& to, const RgbColor& color) {
@@ -587,6 +589,7 @@ OpenGlVideoDriver::MainLoop::Setup::Setup(OpenGlVideoDriver& driver) {
     glBindAttribLocation(program, 0, "vertex");
     glBindAttribLocation(program, 1, "in_color");
     glBindAttribLocation(program, 2, "tex_coord");
+    glBindAttribLocation(program, 3, "in_hue");
     glLinkProgram(program);
     glValidateProgram(program);
     GLint linked;
@@ -600,7 +603,7 @@ OpenGlVideoDriver::MainLoop::Setup::Setup(OpenGlVideoDriver& driver) {
     glGenVertexArrays(1, &array);
     glBindVertexArray(array);
 
-    glGenBuffers(3, driver._vbuf);
+    driver._stream.init();
 
     driver._uniforms.screen.load(program);
     driver._uniforms.scale.load(program);
@@ -611,6 +614,8 @@ OpenGlVideoDriver::MainLoop::Setup::Setup(OpenGlVideoDriver& driver) {
     driver._uniforms.unit.load(program);
     driver._uniforms.outline_color.load(program);
     driver._uniforms.seed.load(program);
+    driver._uniforms.overlay.load(program);
+    driver._uniforms.tints.load(program);
     glUseProgram(program);
 
     GLuint static_texture;
@@ -630,13 +635,38 @@ OpenGlVideoDriver::MainLoop::Setup::Setup(OpenGlVideoDriver& driver) {
     glTexImage2D(
             GL_TEXTURE_2D, 0, GL_RG, size, size, 0, GL_RG, GL_UNSIGNED_BYTE, static_data.get());
 
+    // A row for each hue, with a column for each shade, as given by RgbColor::tint().
+    GLuint tint_texture;
+    glGenTextures(1, &tint_texture);
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D, tint_texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    unique_ptr<uint8_t[]> tint_data(new uint8_t[16 * 256 * 3]);
+    p = tint_data.get();
+    for (int hue = 0; hue < 16; ++hue) {
+        for (int shade = 0; shade < 256; ++shade) {
+            RgbColor tint = RgbColor::tint(Hue(hue), shade);
+            *(p++)        = tint.red;
+            *(p++)        = tint.green;
+            *(p++)        = tint.blue;
+        }
+    }
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 256, 16, 0, GL_RGB, GL_UNSIGNED_BYTE, tint_data.get());
+    glActiveTexture(GL_TEXTURE0);
+
     driver._uniforms.sprite.set(0);
     driver._uniforms.static_image.set(1);
+    driver._uniforms.overlay.set(2);
+    driver._uniforms.tints.set(3);
 }
 
 OpenGlVideoDriver::MainLoop::MainLoop(OpenGlVideoDriver& driver, Card* initial)
         : _setup(driver), _driver(driver), _stack(initial) {}
 
+// Cached layouts own textures, which have to be deleted while the GL context is still around.
+OpenGlVideoDriver::MainLoop::~MainLoop() { StyledText::clear_cached_interfaces(); }
+
 void OpenGlVideoDriver::MainLoop::draw() {
     if (done()) {
         return;
@@ -654,7 +684,10 @@ void OpenGlVideoDriver::MainLoop::draw() {
     seed += _driver._static_seed.next(256);
     _driver._uniforms.seed.set(seed);
 
+    _driver._stream.stats = FrameStats{};
     _stack.top()->draw();
+    _driver._stream.flush();
+    _driver._last_frame_stats = _driver._stream.stats;
 
     glFinish();
 }
@@ -120,6 +120,16 @@ class TextVideoDriver::TextureImpl : public Texture::Impl {
 
     virtual const Size& size() const { return _size; }
 
+    // Sprites packed into an atlas page are logged by frame, as if drawn from their own textures,
+    // so the log doesn't depend on how frames were packed.
+    virtual void draw_hued_quad(
+            const Rect& dest, const Rect& source, Hue hue, pn::string_view frame) const {
+        if (!world().intersects(dest)) {
+            return;
+        }
+        _driver.log("draw", dest.left, dest.top, dest.right, dest.bottom, frame);
+    }
+
   private:
     pn::string       _name;
     TextVideoDriver& _driver;
@@ -180,6 +190,11 @@ Texture TextVideoDriver::texture(pn::string_view name, const PixMap& content, in
     return std::unique_ptr<Texture::Impl>(new TextureImpl(name, *this, content.size()));
 }
 
+Texture TextVideoDriver::hued_texture(
+        pn::string_view name, const PixMap& content, const PixMap& overlay, int scale) {
+    return texture(name, content, scale);
+}
+
 void TextVideoDriver::batch_rect(const Rect& rect, const RgbColor& color) {
     if (!world().intersects(rect)) {
         return;